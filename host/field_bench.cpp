@@ -0,0 +1,149 @@
+/// @file field_bench.cpp
+/// @brief Compare TextFrameBuffer::fieldOut() with snprintf() on the host
+///
+/// Formats the readouts the firmware shows, a current in mA with one
+/// decimal, a frequency, a Q16 level as percent, a register in hex, a
+/// signed offset and a latency in us with one decimal, once with
+/// fieldOut() and once with snprintf() and textOut(), both into the
+/// firmware's TextFrameBuffer built against the Arduino stand-in in
+/// shim/. Checks that both give the same cells for a sweep of values and
+/// prints the time per field of each.
+///
+/// Build: g++ -O2 -Wno-narrowing -Wno-overflow -Ishim -I../source
+///            -o field_bench field_bench.cpp ../source/ST7735.cpp
+///            shim/shim.cpp
+/// Usage: field_bench [fields]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ST7735.hpp"
+
+#define VALUES 1024             ///< values swept per readout
+
+typedef int (*format_fn_t) (char *buf, int32_t v);
+
+/// @brief A readout as fieldOut() and as snprintf() draw it
+struct readout_t {
+    const char *name;
+    field_t field;
+    format_fn_t format;
+    int32_t lo, hi;             ///< range of values swept
+};
+
+static int
+fmt_ma (char *buf, int32_t v)
+{
+    char num[16];
+    uint32_t a = v < 0 ? -v : v;
+    snprintf (num, sizeof (num), "%s%u.%u", v < 0 ? "-" : "", (unsigned) (a / 10), (unsigned) (a % 10));
+    return snprintf (buf, 8, "%5smA", num);
+}
+
+static int
+fmt_hz (char *buf, int32_t v)
+{
+    return snprintf (buf, 8, "%5ldHz", (long) v);
+}
+
+static int
+fmt_pct (char *buf, int32_t v)
+{
+    return snprintf (buf, 6, "%4u%%", (unsigned) (((uint64_t) v * 100 + 0x8000) >> 16));
+}
+
+static int
+fmt_hex (char *buf, int32_t v)
+{
+    return snprintf (buf, 7, "%06lX", (unsigned long) (uint32_t) v);
+}
+
+static int
+fmt_ofs (char *buf, int32_t v)
+{
+    return snprintf (buf, 7, "%+6ld", (long) v);
+}
+
+static int
+fmt_us (char *buf, int32_t v)
+{
+    // as CLatencyTrace::report() prints tenths of us
+    return snprintf (buf, 6, "%3u.%u", (unsigned) (v / 10), (unsigned) (v % 10));
+}
+
+static const readout_t s_readouts[] = {
+    { "current",   field_t (7).fixed (1).unit ("mA"), fmt_ma,  -999, 9999 },
+    { "frequency", field_t (7).unit ("Hz"),           fmt_hz,  1, 99999 },
+    { "level",     field_t (5).percent (),            fmt_pct, 0, 65536 },
+    { "register",  field_t (6).hex ().zero (),        fmt_hex, 0, 0xFFFFFF },
+    { "offset",    field_t (6).plus (),               fmt_ofs, -9999, 9999 },
+    { "latency",   field_t (5).fixed (1),             fmt_us,  0, 9999 },
+};
+
+static TextFrameBuffer s_tfb;
+static int32_t s_values[VALUES];
+
+static double
+seconds ()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/// @brief Compare the cells of both ways of drawing a value
+static bool
+same (const readout_t &r, int32_t v)
+{
+    char buf[16];
+    int n = r.format (buf, v);
+    s_tfb.fieldOut (0, 0, r.field, v);
+    s_tfb.textOut (0, 1, buf, n);
+    s_tfb.render ();
+    const uint8_t *a = s_tfb.shownRow (0), *b = s_tfb.shownRow (1);
+    if ((n == r.field.width) && !memcmp (a, b, 2 * n)) return true;
+    printf ("%s: %ld gives \"", r.name, (long) v);
+    for (int i = 0; i < r.field.width; ++i) putchar (a[2 * i]);
+    printf ("\", snprintf \"%s\"\n", buf);
+    return false;
+}
+
+int
+main (int argc, char **argv)
+{
+    int fields = argc > 1 ? atoi (argv[1]) : 2000000;
+    int failures = 0;
+    const int nreadouts = sizeof (s_readouts) / sizeof (s_readouts[0]);
+    s_tfb.configure (10, 9, 8);
+    s_tfb.setRotation (1);
+
+    printf ("%-10s  %12s  %12s\n", "readout", "ns/fieldOut", "ns/snprintf");
+    for (int i = 0; i < nreadouts; ++i) {
+        const readout_t &r = s_readouts[i];
+        srand (i + 1);
+        for (int n = 0; n < VALUES; ++n) {
+            s_values[n] = r.lo + (int32_t) ((uint32_t) rand () % (uint32_t) (r.hi - r.lo + 1));
+            if (!same (r, s_values[n])) {
+                ++failures;
+                break;
+            }
+        }
+        if (!same (r, r.lo) || !same (r, r.hi)) ++failures;
+
+        double t0 = seconds ();
+        for (int n = 0; n < fields; ++n)
+            s_tfb.fieldOut (0, n & 7, r.field, s_values[n & (VALUES - 1)]);
+        double t1 = seconds ();
+        for (int n = 0; n < fields; ++n) {
+            char buf[16];
+            int len = r.format (buf, s_values[n & (VALUES - 1)]);
+            s_tfb.textOut (0, n & 7, buf, len);
+        }
+        double t2 = seconds ();
+        printf ("%-10s  %12.1f  %12.1f\n", r.name,
+                (t1 - t0) / fields * 1e9, (t2 - t1) / fields * 1e9);
+    }
+    printf ("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
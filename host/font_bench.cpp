@@ -0,0 +1,136 @@
+/// @file font_bench.cpp
+/// @brief Compare the font storage layouts on the host
+///
+/// Transcodes font6x8H.i to every layout of font.hpp in one program, 
+/// checks that all decode to the same pixel rows, and times the two 
+/// decode paths of the firmware: TextFrameBuffer::render() decodes each
+/// character of a text row once and assembles its RGB565 scanlines, and
+/// drawChar() decodes a single glyph. Prints flash size and time per 
+/// full 26x16 screen and per glyph for each layout.
+///
+/// Build: g++ -O2 -I../source -o font_bench font_bench.cpp
+/// Usage: font_bench [screens]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "font.hpp"
+
+#define COLS 26                 ///< text columns in landscape
+#define ROWS 16                 ///< text rows in landscape
+
+#undef FONT_GLYPH
+#define FONT_GLYPH FONT_ROWS_GLYPH
+static const uint8_t s_rows[] = {
+#include "font6x8H.i"
+};
+#undef FONT_GLYPH
+#define FONT_GLYPH FONT_COLS_GLYPH
+static const uint8_t s_cols[] = {
+#include "font6x8H.i"
+};
+#undef FONT_GLYPH
+#define FONT_GLYPH FONT_PACK6_GLYPH
+static const uint8_t s_pack6[] = {
+#include "font6x8H.i"
+};
+
+typedef const uint8_t *(*decode_fn_t) (const uint8_t *, uint8_t, uint8_t *);
+
+struct layout_t {
+    const char *name;
+    const uint8_t *font;
+    unsigned size;
+    decode_fn_t decode;
+};
+
+static const layout_t s_layouts[] = {
+    { "FONT_ROWS",  s_rows,  sizeof (s_rows),  font_rows_glyph },
+    { "FONT_COLS",  s_cols,  sizeof (s_cols),  font_cols_glyph },
+    { "FONT_PACK6", s_pack6, sizeof (s_pack6), font_pack6_glyph },
+};
+
+static uint8_t s_text[ROWS][COLS];
+static uint16_t s_scanline[COLS * FONTWIDTH];
+static volatile uint32_t s_sink;
+
+static double
+seconds ()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/// @brief Render a screen as render_rect() does, with the layout's kernel
+static inline void
+screen (const uint8_t *font, decode_fn_t decode)
+{
+    uint8_t glyphs[COLS][FONTHEIGHT];
+    const uint8_t *rows[COLS];
+    const uint16_t fg = 0xFFFF, bg = 0x0000;
+    for (int y = 0; y < ROWS; ++y) {
+        for (int x = 0; x < COLS; ++x)
+            rows[x] = decode (font, s_text[y][x], glyphs[x]);
+        for (int jj = 0; jj < FONTHEIGHT; ++jj) {
+            uint16_t *dst = s_scanline;
+            for (int x = 0; x < COLS; ++x) {
+                uint8_t line = rows[x][jj];
+                for (int i = 0; i < FONTWIDTH; ++i)
+                    *dst++ = (line & (1 << i)) ? fg : bg;
+            }
+            s_sink += s_scanline[jj];
+        }
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+    int screens = argc > 1 ? atoi (argv[1]) : 20000;
+    int failures = 0;
+    const int nlayouts = sizeof (s_layouts) / sizeof (s_layouts[0]);
+
+    // every layout decodes to the rows of the source
+    for (int l = 1; l < nlayouts; ++l) {
+        for (int c = 0; c < 256; ++c) {
+            uint8_t a[FONTHEIGHT], b[FONTHEIGHT];
+            const uint8_t *ra = font_rows_glyph (s_rows, c, a);
+            const uint8_t *rb = s_layouts[l].decode (s_layouts[l].font, c, b);
+            if (memcmp (ra, rb, FONTHEIGHT)) {
+                printf ("%s: character 0x%02x decodes wrong\n", 
+                        s_layouts[l].name, c);
+                ++failures;
+                break;
+            }
+        }
+    }
+
+    srand (1);
+    for (int y = 0; y < ROWS; ++y)
+        for (int x = 0; x < COLS; ++x)
+            s_text[y][x] = (uint8_t) rand ();
+
+    printf ("%-10s  %5s  %10s  %10s\n", "layout", "bytes", "us/screen", "ns/glyph");
+    for (int l = 0; l < nlayouts; ++l) {
+        const layout_t &L = s_layouts[l];
+        double t0 = seconds ();
+        for (int n = 0; n < screens; ++n) {
+            s_text[n % ROWS][n % COLS] += 1;
+            screen (L.font, L.decode);
+        }
+        double t1 = seconds ();
+        const int glyphs = screens * 100;
+        for (int n = 0; n < glyphs; ++n) {
+            uint8_t g[FONTHEIGHT];
+            const uint8_t *r = L.decode (L.font, (uint8_t) n, g);
+            s_sink += r[n & (FONTHEIGHT - 1)];
+        }
+        double t2 = seconds ();
+        printf ("%-10s  %5u  %10.2f  %10.2f\n", L.name, L.size,
+                (t1 - t0) / screens * 1e6, (t2 - t1) / glyphs * 1e9);
+    }
+    printf ("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
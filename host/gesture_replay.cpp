@@ -0,0 +1,102 @@
+/// @file gesture_replay.cpp
+/// @brief Replay timestamped knob edges through the gesture recognizer
+///
+/// Each script lists knob edges as the knob interrupt records them: Pt
+/// presses, Rt releases, +t and -t turn one detent right or left, all at
+/// t ms. They pass through the firmware's CGesture the way the main loop
+/// drives it, calling expire() once its deadline() has passed before
+/// each edge and at the end, and the gestures are compared with the
+/// expected ones: C click, D double-click, L long press, T turn and
+/// X turn while pressed, with the turn's detents and the ms it completed.
+///
+/// Build: g++ -O2 -Ishim -I../source -o gesture_replay gesture_replay.cpp
+///            ../source/gesture.cpp
+/// Usage: gesture_replay ["script"]   e.g. "P0 R80 P200 R260"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gesture.hpp"
+
+/// @brief A script and the gestures it must give with default timing
+struct replay_case_t {
+    const char *name;
+    const char *script;
+    const char *expect;
+};
+
+static const replay_case_t s_cases[] = {
+    { "click", "P0 R80", "C380" },
+    { "double-click", "P0 R80 P200 R260", "D260" },
+    { "two clicks", "P0 R80 P500 R560", "C380 C860" },
+    { "long press", "P0 R900", "L600" },
+    { "long press, turns", "P0 +700 +720 R900", "L600 X1@700 X1@720" },
+    { "coarse turn", "P0 +100 +120 -140 R300", "X1@100 X1@120 X-1@140" },
+    { "fine turn", "+0 +10 +20 -30", "T1@0 T1@10 T1@20 T-1@30" },
+    { "click, turn", "P0 R80 +150", "C150 T1@150" },
+    { "click, coarse turn", "P0 R80 P200 -250 R400", "C80 X-1@250" },
+    { "click, long press", "P0 R80 P200 R1000", "C80 L800" },
+    { "stray release", "R0 P100 R150", "C450" },
+};
+
+static const char s_names[] = "CDLTX";
+
+/// @brief Run a script, writing the gestures as text
+static void
+replay (const char *script, char *out, size_t size)
+{
+    CGesture g;
+    knob_event_t e;
+    gesture_t r;
+    uint32_t at;
+    out[0] = 0;
+    const char *p = script;
+    for (;;) {
+        while (*p == ' ') ++p;
+        bool end = (*p == 0);
+        char c = *p;
+        uint32_t t = end ? 0xFFFFFF : (uint32_t) strtoul (p + 1, (char **) &p, 10);
+        // the main loop wakes at the deadline before the next edge
+        if (g.deadline (&at) && (int32_t) (t - at) >= 0) g.expire (at);
+        if (!end) {
+            e.stamp = t;
+            e.step = (c == '+') ? 1 : (c == '-') ? -1 : 0;
+            e.edge = (c == 'P') ? KNOB_PRESS : (c == 'R') ? KNOB_RELEASE
+                   : KNOB_TURN;
+            g.feed (e);
+        }
+        while (g.next (&r)) {
+            size_t n = strlen (out);
+            if (r.kind >= GESTURE_TURN)
+                snprintf (out + n, size - n, "%s%c%d@%u", n ? " " : "",
+                          s_names[r.kind], (int) r.delta, r.stamp);
+            else
+                snprintf (out + n, size - n, "%s%c%u", n ? " " : "",
+                          s_names[r.kind], r.stamp);
+        }
+        if (end) break;
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+    char out[256];
+    if (argc > 1) {
+        replay (argv[1], out, sizeof (out));
+        printf ("%s\n", out);
+        return 0;
+    }
+
+    int failures = 0;
+    for (size_t i = 0; i < sizeof (s_cases) / sizeof (s_cases[0]); ++i) {
+        const replay_case_t &c = s_cases[i];
+        replay (c.script, out, sizeof (out));
+        bool ok = !strcmp (out, c.expect);
+        printf ("%-20s %-28s %s%s%s\n", c.name, c.script, out,
+                ok ? "" : "  expected ", ok ? "" : c.expect);
+        if (!ok) ++failures;
+    }
+    printf ("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
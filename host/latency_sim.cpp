@@ -0,0 +1,105 @@
+/// @file latency_sim.cpp
+/// @brief Simulate knob-to-glass and knob-to-output latency on the host
+///
+/// Synthetic encoder detents with random spacing are stamped as the knob
+/// interrupt would. A simulated main loop queries the knob, does other
+/// work, renders dirty rows at the panel's SPI rate, either blocking or
+/// in renderSlice() steps, and sets a modulator update that the synth 
+/// refill takes at its next block. Stamps go into the firmware's 
+/// CLatencyTrace, which prints the diagnostics screen's table.
+///
+/// Build: g++ -O2 -I../source -o latency_sim latency_sim.cpp ../source/latency.cpp
+/// Usage: latency_sim [events [workus [bgrows [slicerows]]]]
+///        bgrows     rows redrawn every loop by other widgets, e.g. meters
+///        slicerows  rows rendered per loop, 0 for a blocking render()
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "latency.hpp"
+
+#define MCK 84000000u                   ///< cycle counter rate
+#define PERUS (MCK / 1000000)           ///< cycles per us
+#define SPI_HZ 14000000u                ///< panel SPI clock
+#define ROW_BYTES (26 * 6 * 8 * 2)      ///< bytes of a full text row
+#define ROW_CYCLES ((uint64_t) ROW_BYTES * 8 * MCK / SPI_HZ)
+#define BLOCK_CYCLES (64u * (MCK / 20000))  ///< synth block period
+#define ROWS 16                         ///< text rows in landscape
+
+static uint32_t
+uniform (uint32_t lo, uint32_t hi)
+{
+    return lo + (uint32_t) (rand () % (hi - lo + 1));
+}
+
+int
+main (int argc, char **argv)
+{
+    uint32_t events = argc > 1 ? atoi (argv[1]) : 2000;
+    uint32_t workus = argc > 2 ? atoi (argv[2]) : 500;
+    uint32_t bgrows = argc > 3 ? atoi (argv[3]) : 2;
+    uint32_t slice = argc > 4 ? atoi (argv[4]) : 0;
+    srand (1);
+
+    CLatencyTrace trace (PERUS);
+    uint64_t t = 0;                         // now, in cycles
+    uint64_t edge = uniform (10, 200) * 1000ULL * PERUS;  // next detent
+    uint64_t pending = 0;                   // first unqueried edge, or 0
+    uint32_t dirty = 0;                     // dirty rows, one bit each
+    uint32_t row = 0;                       // row the next slice starts at
+    uint64_t passstart = 0;                 // start of the current pass
+    bool framerows = false;
+    uint32_t n = 0;
+
+    while (n < events) {
+        // edges up to now were stamped by the interrupt
+        while (edge <= t) {
+            if (!pending) pending = edge;
+            edge += uniform (10, 200) * 1000ULL * PERUS;
+        }
+        // query: the event changes one row and one modulator
+        if (pending) {
+            trace.knob ((uint32_t) pending, (uint32_t) t);
+            pending = 0;
+            ++n;
+            dirty |= 1u << uniform (bgrows, ROWS - 1);
+            // the refill after the update takes it; it plays a block later
+            uint64_t refill = (t / BLOCK_CYCLES + 1) * BLOCK_CYCLES;
+            trace.output ((uint32_t) (refill + BLOCK_CYCLES));
+        }
+        dirty |= (1u << bgrows) - 1;
+        t += (uint64_t) workus * PERUS * uniform (50, 150) / 100;
+
+        // render as renderSlice() does: continue the pass at row, at most
+        // slice rows, and end the pass when no dirty row is left below
+        uint32_t max = slice ? slice : ROWS;
+        for (;;) {
+            if (row == 0) passstart = t;
+            uint32_t done = 0;
+            for (; row < ROWS && done < max; ++row)
+                if (dirty & (1u << row)) {
+                    dirty &= ~(1u << row);
+                    t += ROW_CYCLES;
+                    framerows = true;
+                    ++done;
+                }
+            if (dirty >> row) break;
+            row = 0;
+            if (framerows) trace.frame ((uint32_t) passstart, (uint32_t) t);
+            framerows = false;
+            // render () loops until nothing is dirty, a slice returns
+            if (slice || !dirty) break;
+        }
+        trace.expire ((uint32_t) t);
+        // an idle loop still takes a little time
+        t += 20 * PERUS;
+    }
+
+    printf ("work %u us, %u background rows, %s\n", workus, bgrows,
+            slice ? "sliced render" : "blocking render");
+    for (uint8_t i = 0; i < LAT_LINES; ++i) {
+        char line[27];
+        trace.report (i, line);
+        printf ("%s\n", line);
+    }
+    return 0;
+}
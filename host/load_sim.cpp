@@ -0,0 +1,311 @@
+/// @file load_sim.cpp
+/// @brief Closed-loop model of the output boards driving a body load
+///
+/// Streams the firmware's output pipeline block by block, as CSynth does
+/// in the DACC interrupt: CSequencer (or fixed voices), CModulator levels,
+/// CWaveVoice rendering and the CSafety limits. Each channel's DAC codes
+/// then drive a behavioural model of one output channel, stepped at
+/// OVERSAMPLE times the sample rate with the DAC holding its value:
+///
+///   DAC        0.55 - 2.75 V, as the SAM3X DACC with a 3.3 V reference
+///   opamp      ChannelOutput-x2-opamp only: MCP602 at 3.3 V, 100 kOhm /
+///              10 uF input coupling, gain, 2.3 V/us slew, rail clamp
+///   amplifier  TIP41C / IRF9530 stage on V+: gain, rail clamp, output
+///              resistance of R7 (1 Ohm) plus the winding
+///   transformer 42T audio transformer, ideal ratio 1:N with the
+///              magnetizing inductance across the primary
+///   body       series resistance Rs, then Rp parallel to Cp, the usual
+///              electrode and skin model
+///
+/// The linear part is solved with backward Euler, so it stays stable for
+/// any time constant. Reports per channel the peak body current, RMS
+/// current and power, and the charge of each pulse, i.e. of each run of
+/// current in one direction ended by 1 mA the other way, with the net
+/// charge left in the body. Fails if the peak current exceeds -I. All
+/// component values are nominal and can be overridden, see Usage.
+///
+/// Build: g++ -O2 -I../source -o load_sim load_sim.cpp ../source/wavegen.cpp
+///            ../source/modulate.cpp ../source/safety.cpp ../source/sequence.cpp
+/// Usage: load_sim [-p program.txt] [-s seconds] [-r rate] [-x] [-I mA]
+///                 [-L level%] [-R ohm] [-S ohm] [-C nF] [-N ratio] [-V volt]
+///        -p  program text, @see CProgram; default sine 80 Hz at 50%
+///        -x  model ChannelOutput without the opamp stage
+///        -I  peak body current limit, default 50 mA
+///        -L  CSafety level limit, default 100%
+///        -R -S -C  body Rp, Rs and Cp, default 1000, 200, 100
+///        -N  transformer ratio, default 11; -V  supply V+, default 12
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "wavegen.hpp"
+#include "modulate.hpp"
+#include "safety.hpp"
+#include "sequence.hpp"
+
+#define BLOCK 64                ///< samples per block, as SYNTH_BLOCK
+#define CHANNELS 2              ///< output channels, as SYNTH_CHANNELS
+#define OVERSAMPLE 8            ///< model steps per sample
+#define PULSE_THRESHOLD 1e-3    ///< current in A reversing a pulse
+
+/// @brief Component values of one output channel
+struct circuit_t {
+    bool   opamp;               ///< MCP602 stage fitted
+    double opgain;              ///< opamp stage voltage gain
+    double opslew;              ///< opamp slew rate in V/s
+    double coupling;            ///< input coupling time constant in s
+    double vcc;                 ///< opamp supply in V
+    double ampgain;             ///< amplifier voltage gain
+    double supply;              ///< amplifier supply V+ in V
+    double headroom;            ///< amplifier saturation below the rails
+    double rout;                ///< amplifier output and winding resistance
+    double lm;                  ///< magnetizing inductance, primary side
+    double ratio;               ///< secondary to primary turns
+    double rs;                  ///< body series resistance
+    double rp;                  ///< body parallel resistance
+    double cp;                  ///< body parallel capacitance
+};
+
+/// @brief Behavioural model of one output channel and its load
+class CChannelModel {
+public:
+    CChannelModel (const circuit_t &c, double dt)
+    : m_c (c), m_dt (dt), m_in (0), m_hp (0), m_op (0), m_il (0), m_vc (0),
+      m_peak (0), m_sumi2 (0), m_sump (0), m_n (0), m_q (0), m_qnet (0),
+      m_qmax (0), m_qsum (0), m_pulses (0), m_sign (0), m_settled (false)
+    {
+        // secondary-referred source resistance and magnetizing inductance
+        m_rsrc = c.rout * c.ratio * c.ratio;
+        m_lm = c.lm * c.ratio * c.ratio;
+        m_a = c.cp / dt;
+        m_k = m_a + 1 / c.rs + 1 / c.rp;
+        m_g = 1 / m_rsrc + dt / m_lm + 1 / c.rs - 1 / (m_k * c.rs * c.rs);
+        m_alpha = c.coupling / (c.coupling + dt);
+    }
+
+    /// @brief Advance by one step with a DAC output voltage
+    void step (double vdac)
+    {
+        // AC coupling into the first stage, backward Euler high-pass,
+        // charged to the first DAC level as after power-up
+        if (!m_settled) {
+            m_in = vdac;
+            m_op = m_c.vcc / 2;
+            m_settled = true;
+        }
+        m_hp = m_alpha * (m_hp + vdac - m_in);
+        m_in = vdac;
+        double v = m_hp;
+        if (m_c.opamp) {
+            // around mid supply, slew limited, clamped to the rails
+            double target = m_c.vcc / 2 + m_c.opgain * v;
+            double dv = target - m_op, max = m_c.opslew * m_dt;
+            m_op += (dv > max) ? max : (dv < -max) ? -max : dv;
+            if (m_op < 0.02) m_op = 0.02;
+            if (m_op > m_c.vcc - 0.02) m_op = m_c.vcc - 0.02;
+            v = m_op - m_c.vcc / 2;
+        }
+        double swing = m_c.supply / 2 - m_c.headroom;
+        double vamp = m_c.ampgain * v;
+        if (vamp > swing) vamp = swing;
+        if (vamp < -swing) vamp = -swing;
+
+        // secondary node voltage, then the inductor and capacitor states
+        double vs = vamp * m_c.ratio;
+        double vsec = (vs / m_rsrc - m_il + m_a * m_vc / (m_k * m_c.rs)) / m_g;
+        m_il += vsec * m_dt / m_lm;
+        m_vc = (m_a * m_vc + vsec / m_c.rs) / m_k;
+        double i = (vsec - m_vc) / m_c.rs;
+        measure (i, i * i * m_c.rs + m_vc * m_vc / m_c.rp);
+    }
+
+    /// @brief Close the pulse in progress
+    void finish () { pulse (0); }
+
+    double peak () const { return m_peak; }
+    double rmsCurrent () const { return m_n ? sqrt (m_sumi2 / m_n) : 0; }
+    double power () const { return m_n ? m_sump / m_n : 0; }
+    double netCharge () const { return m_qnet; }
+    double maxCharge () const { return m_qmax; }
+    double meanCharge () const { return m_pulses ? m_qsum / m_pulses : 0; }
+    uint32_t pulses () const { return m_pulses; }
+
+protected:
+    void measure (double i, double p)
+    {
+        if (fabs (i) > m_peak) m_peak = fabs (i);
+        m_sumi2 += i * i;
+        m_sump += p;
+        ++m_n;
+        m_qnet += i * m_dt;
+        // a pulse is a run of current in one direction; it ends once the
+        // current exceeds PULSE_THRESHOLD the other way, so the chatter of
+        // the DAC steps around a zero crossing stays within one pulse
+        int sign = (i > PULSE_THRESHOLD) ? 1 : (i < -PULSE_THRESHOLD) ? -1 : 0;
+        if (sign && (sign != m_sign)) pulse (sign);
+        m_q += i * m_dt;
+    }
+
+    void pulse (int sign)
+    {
+        if (m_sign) {
+            double q = fabs (m_q);
+            if (q > m_qmax) m_qmax = q;
+            m_qsum += q;
+            ++m_pulses;
+        }
+        m_sign = sign;
+        m_q = 0;
+    }
+
+protected:
+    circuit_t m_c;
+    double m_dt, m_rsrc, m_lm, m_a, m_k, m_g, m_alpha;
+    double m_in, m_hp, m_op, m_il, m_vc;
+    double m_peak, m_sumi2, m_sump;
+    uint64_t m_n;
+    double m_q, m_qnet, m_qmax, m_qsum;
+    uint32_t m_pulses;
+    int m_sign;
+    bool m_settled;
+};
+
+static double
+seconds ()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int
+main (int argc, char **argv)
+{
+    circuit_t c = { true, 2.0, 2.3e6, 1.0, 3.3, 4.0, 12.0, 1.5, 3.0, 5e-3,
+                    11.0, 200.0, 1000.0, 100e-9 };
+    const char *path = 0;
+    double secs = 0, limit = 50e-3, level = 100;
+    uint32_t rate = 20000;
+    for (int i = 1; i < argc; ++i) {
+        const char *a = argv[i];
+        double v = (i + 1 < argc) ? atof (argv[i + 1]) : 0;
+        if (!strcmp (a, "-x")) { c.opamp = false; continue; }
+        if (i + 1 >= argc) {
+            fprintf (stderr, "%s needs a value\n", a);
+            return 2;
+        }
+        if (!strcmp (a, "-p")) path = argv[i + 1];
+        else if (!strcmp (a, "-s")) secs = v;
+        else if (!strcmp (a, "-r")) rate = (uint32_t) v;
+        else if (!strcmp (a, "-I")) limit = v * 1e-3;
+        else if (!strcmp (a, "-L")) level = v;
+        else if (!strcmp (a, "-R")) c.rp = v;
+        else if (!strcmp (a, "-S")) c.rs = v;
+        else if (!strcmp (a, "-C")) c.cp = v * 1e-9;
+        else if (!strcmp (a, "-N")) c.ratio = v;
+        else if (!strcmp (a, "-V")) c.supply = v;
+        else {
+            fprintf (stderr, "unknown option %s\n", a);
+            return 2;
+        }
+        ++i;
+    }
+
+    // the sample source: a program, or a fixed sine on both channels
+    static CProgram prog;
+    static CSequencer seq;
+    if (path) {
+        static char text[65536];
+        FILE *f = fopen (path, "rb");
+        if (!f) {
+            perror (path);
+            return 2;
+        }
+        text[fread (text, 1, sizeof (text) - 1, f)] = 0;
+        fclose (f);
+        if (!prog.parse (text, rate, BLOCK)) {
+            printf ("%s:%u: %s\n", path, prog.errorLine (), prog.error ());
+            return 2;
+        }
+        seq.load (prog.table ());
+        seq.resume ();
+        if (secs <= 0) {
+            for (uint8_t ch = 0; ch < CHANNELS; ++ch)
+                if (prog.blocks (ch) * (double) BLOCK / rate > secs)
+                    secs = prog.blocks (ch) * (double) BLOCK / rate;
+        }
+    }
+    if (secs <= 0) secs = 10;
+
+    CWaveVoice voice[CHANNELS];
+    CModulator mod[CHANNELS];
+    CSafety safety;
+    safety.configure (rate / BLOCK, 1500, 50, 200);
+    for (uint8_t ch = 0; ch < CHANNELS; ++ch) {
+        voice[ch].setFrequency (80000, rate);
+        mod[ch].setBlockRate (rate / BLOCK);
+        mod[ch].rampTo (path ? 32768 : 16384, 0);
+        safety.setLimits (ch, (uint16_t) (level * 32768 / 100), DAC_MAX);
+    }
+
+    const double dt = 1.0 / rate / OVERSAMPLE;
+    CChannelModel *model[CHANNELS];
+    for (uint8_t ch = 0; ch < CHANNELS; ++ch) model[ch] = new CChannelModel (c, dt);
+
+    uint32_t blocks = (uint32_t) (secs * rate / BLOCK);
+    uint16_t buf[CHANNELS * BLOCK];
+    double pipeline = 0, modelled = 0;
+    for (uint32_t b = 0; b < blocks; ++b) {
+        // the pipeline of CSynth::refill() and CSupervisor::block()
+        double t0 = seconds ();
+        if (path) seq.next ();
+        for (uint8_t ch = 0; ch < CHANNELS; ++ch) {
+            uint32_t l = mod[ch].next ();
+            if (path) {
+                const seq_out_t &out = seq.out (ch);
+                voice[ch].setShape (out.shape);
+                voice[ch].setIncrement (out.inc);
+                l = (l * out.level) >> 15;
+            }
+            voice[ch].glide (l);
+            voice[ch].render (buf + ch, BLOCK, CHANNELS, ch << 12);
+        }
+        safety.apply (buf, BLOCK);
+        double t1 = seconds ();
+        for (uint16_t i = 0; i < BLOCK; ++i) {
+            for (uint8_t ch = 0; ch < CHANNELS; ++ch) {
+                double vdac = 3.3 / 6 + (buf[i * CHANNELS + ch] & DAC_MAX)
+                            * (3.3 * 4 / 6) / DAC_MAX;
+                for (int k = 0; k < OVERSAMPLE; ++k) model[ch]->step (vdac);
+            }
+        }
+        modelled += seconds () - t1;
+        pipeline += t1 - t0;
+    }
+
+    int failures = 0;
+    printf ("%s board, %.1f s at %u Hz, body Rs %.0f + Rp %.0f || Cp %.0f nF,"
+            " ratio 1:%.1f, V+ %.1f V\n", c.opamp ? "opamp" : "plain", secs,
+            rate, c.rs, c.rp, c.cp * 1e9, c.ratio, c.supply);
+    for (uint8_t ch = 0; ch < CHANNELS; ++ch) {
+        CChannelModel &m = *model[ch];
+        m.finish ();
+        printf ("ch %u: peak %.2f mA, rms %.2f mA, power %.2f mW, %u pulses "
+                "of %.3f uC mean %.3f uC max, net %.3f uC\n", ch,
+                m.peak () * 1e3, m.rmsCurrent () * 1e3, m.power () * 1e3,
+                m.pulses (), m.meanCharge () * 1e6, m.maxCharge () * 1e6,
+                m.netCharge () * 1e6);
+        if (m.peak () > limit) {
+            printf ("ch %u: peak current above the %.1f mA limit\n", ch, limit * 1e3);
+            ++failures;
+        }
+    }
+    printf ("pipeline %.1f ns/sample, model %.1f ns/sample, %.1fx real time\n",
+            pipeline / (blocks * (double) BLOCK * CHANNELS) * 1e9,
+            modelled / (blocks * (double) BLOCK * CHANNELS) * 1e9,
+            secs / (pipeline + modelled));
+    printf ("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,164 @@
+/// @file preset_sim.cpp
+/// @brief Exercise the preset log against simulated flash on the host
+///
+/// A RAM image stands in for the flash region. Page programming can be 
+/// torn at a random byte, as by power loss, after which the log is 
+/// rebuilt from the image and every id must still load its last 
+/// completed save, or the interrupted one if the tear missed its 
+/// payload. Random bit flips must never yield a payload that was not 
+/// saved. Finally per-page erase counts show the wear leveling and 
+/// begin()/load() are timed.
+///
+/// Build: g++ -O2 -I../source -o preset_sim preset_sim.cpp ../source/presetlog.cpp
+/// Usage: preset_sim [pages [ids [saves [seed]]]]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "presetlog.hpp"
+
+static uint8_t s_flash[PRESET_MAXPAGES * PRESET_PAGE];  ///< flash image
+static uint32_t s_erases[PRESET_MAXPAGES];              ///< erases per page
+static int32_t s_tear = -1;     ///< programs until power loss, -1 = never
+
+/// @brief Simulated erase and program of one page
+static bool
+program (uint16_t page, const uint32_t *data)
+{
+    uint8_t *dst = s_flash + page * PRESET_PAGE;
+    memset (dst, 0xFF, PRESET_PAGE);
+    ++s_erases[page];
+    if (s_tear == 0) {
+        // power fails part way through programming
+        uint32_t n = rand () % PRESET_PAGE;
+        memcpy (dst, data, n);
+        s_tear = -1;
+        return false;
+    }
+    if (s_tear > 0) --s_tear;
+    memcpy (dst, data, PRESET_PAGE);
+    return true;
+}
+
+/// @brief Payload of version v of an id, length varying with both
+static uint8_t
+payload (uint8_t id, uint32_t v, uint8_t *buf)
+{
+    uint8_t len = 1 + (id * 7 + v) % PRESET_MAXDATA;
+    for (uint8_t i = 0; i < len; ++i)
+        buf[i] = (uint8_t) (id * 31 + v * 17 + i);
+    return len;
+}
+
+static double
+seconds ()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int
+main (int argc, char **argv)
+{
+    uint16_t pages = argc > 1 ? atoi (argv[1]) : 64;
+    uint8_t ids = argc > 2 ? atoi (argv[2]) : 16;
+    uint32_t saves = argc > 3 ? atoi (argv[3]) : 20000;
+    srand (argc > 4 ? atoi (argv[4]) : 1);
+    if ((pages > PRESET_MAXPAGES) || (ids > PRESET_MAXIDS) || (ids + 2 > pages)) {
+        fprintf (stderr, "need ids + 2 <= pages <= %d, ids <= %d\n", 
+                 PRESET_MAXPAGES, PRESET_MAXIDS);
+        return 2;
+    }
+    int failures = 0;
+    if (CPresetLog::crc32 ("123456789", 9) != 0xCBF43926) {
+        printf ("crc32 check value wrong\n");
+        ++failures;
+    }
+
+    static CPresetLog log;
+    static uint32_t committed[PRESET_MAXIDS];   // last completed version + 1
+    uint8_t buf[PRESET_MAXDATA], want[PRESET_MAXDATA];
+    memset (s_flash, 0xFF, sizeof (s_flash));
+    log.begin (s_flash, pages, program);
+
+    // random saves, with power lost during one program in every 50
+    uint32_t tears = 0;
+    for (uint32_t n = 1; n <= saves; ++n) {
+        uint8_t id = rand () % ids;
+        if (rand () % 50 == 0) s_tear = rand () % 2;
+        uint8_t len = payload (id, n, buf);
+        bool ok = log.save (id, buf, len);
+        if (ok) committed[id] = n + 1;
+        if (s_tear < 0 && !ok) {
+            // power loss: reboot from the image
+            ++tears;
+            log.begin (s_flash, pages, program);
+            for (uint8_t i = 0; i < ids; ++i) {
+                uint8_t got = log.load (i, buf, sizeof (buf));
+                // a tear past the end of the payload completes the save
+                if ((i == id) && (got == payload (id, n, want)) 
+                    && !memcmp (buf, want, got)) {
+                    committed[id] = n + 1;
+                    continue;
+                }
+                uint8_t exp = committed[i] ? payload (i, committed[i] - 1, want) : 0;
+                if ((got != exp) || memcmp (buf, want, got)) {
+                    printf ("id %u lost after power loss at save %u\n", i, n);
+                    ++failures;
+                }
+            }
+        }
+        s_tear = -1;
+    }
+
+    // bit flips: every surviving record must be a version once saved
+    uint32_t flipped = 0, survived = 0;
+    for (uint32_t i = 0; i < pages * 2u; ++i) {
+        s_flash[rand () % (pages * PRESET_PAGE)] ^= 1 << (rand () % 8);
+        ++flipped;
+    }
+    log.begin (s_flash, pages, program);
+    for (uint8_t i = 0; i < ids; ++i) {
+        uint8_t got = log.load (i, buf, sizeof (buf));
+        if (got == 0) continue;
+        bool known = false;
+        for (uint32_t v = 1; v <= saves && !known; ++v) {
+            uint8_t len = payload (i, v, want);
+            known = (len == got) && !memcmp (buf, want, len);
+        }
+        if (!known) {
+            printf ("id %u loaded a corrupted payload\n", i);
+            ++failures;
+        }
+        ++survived;
+    }
+
+    uint32_t emin = 0xFFFFFFFF, emax = 0, writes = 0;
+    for (uint16_t p = 0; p < pages; ++p) {
+        writes += s_erases[p];
+        if (s_erases[p] < emin) emin = s_erases[p];
+        if (s_erases[p] > emax) emax = s_erases[p];
+    }
+
+    // load time: index rebuild at boot and one preset copy
+    const int reps = 2000;
+    double t0 = seconds ();
+    for (int i = 0; i < reps; ++i)
+        log.begin (s_flash, pages, program);
+    double t1 = seconds ();
+    volatile uint32_t sink = 0;
+    for (int i = 0; i < reps * 100; ++i)
+        sink += log.load (i % ids, buf, sizeof (buf));
+    double t2 = seconds ();
+
+    printf ("%u saves, %u page writes, %u power losses, %u bit flips, "
+            "%u/%u ids survived\n", saves, writes, tears, flipped,
+            survived, ids);
+    printf ("erases per page: min %u max %u\n", emin, emax);
+    printf ("begin %.1f us, load %.1f ns\n", (t1 - t0) / reps * 1e6,
+            (t2 - t1) / (reps * 100) * 1e9);
+    printf ("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,166 @@
+/// @file program_check.cpp
+/// @brief Validate a stimulation program and estimate its footprint
+///
+/// Compiles program text with the firmware's CProgram, as the Due would
+/// at load time, and reports per channel the segments, duration and 
+/// level jumps without a transition. Walks the table with CSequencer 
+/// block by block and checks that seeks to random times land on the 
+/// same outputs as the continuous walk. Prints the table size in flash,
+/// the RAM of the compiler and the sequencer, and the host time per 
+/// next() call. With -e, prints the compiled table as C source to keep
+/// in flash instead of compiling on the board.
+///
+/// Build: g++ -O2 -I../source -o program_check program_check.cpp
+///            ../source/sequence.cpp ../source/wavegen.cpp
+/// Usage: program_check [-e name] [-r rate] program.txt
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "wavegen.hpp"
+#include "sequence.hpp"
+
+#define BLOCK 64                ///< samples per block, as SYNTH_BLOCK
+
+static const char *const s_shapes[WAVE_SHAPES] = {
+    "sine", "square", "triangle", "saw"
+};
+
+static double
+seconds ()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/// @brief Print the table as C source
+static void
+emit (const seq_table_t *t, const char *name)
+{
+    uint16_t n = 0;
+    for (uint8_t ch = 0; ch < SEQ_CHANNELS; ++ch) n += t->count[ch];
+    printf ("// compiled for %u Hz, %u samples per block\n", t->rate, t->block);
+    printf ("static const seq_step_t %s_steps[%u] = {\n", name, n);
+    for (uint16_t i = 0; i < n; ++i) {
+        const seq_step_t &s = t->steps[i];
+        printf ("    { %u, 0x%08X, %d, %d, %u, %u, %u },\n", s.blocks, s.inc,
+                s.dinc, s.dlevel, s.ramp, s.level, s.shape);
+    }
+    // extern, so other translation units can refer to the table
+    printf ("};\nextern const seq_table_t %s;\n", name);
+    printf ("const seq_table_t %s = { %s_steps, {", name, name);
+    for (uint8_t ch = 0; ch < SEQ_CHANNELS; ++ch)
+        printf (" %u%s", t->count[ch], ch + 1 < SEQ_CHANNELS ? "," : "");
+    printf (" }, %u, %u };\n", t->rate, t->block);
+}
+
+int
+main (int argc, char **argv)
+{
+    const char *name = 0, *path = 0;
+    uint32_t rate = 20000;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp (argv[i], "-e") && (i + 1 < argc)) name = argv[++i];
+        else if (!strcmp (argv[i], "-r") && (i + 1 < argc)) rate = atoi (argv[++i]);
+        else path = argv[i];
+    }
+    if (!path) {
+        fprintf (stderr, "usage: %s [-e name] [-r rate] program.txt\n", argv[0]);
+        return 2;
+    }
+    FILE *f = fopen (path, "rb");
+    if (!f) {
+        perror (path);
+        return 2;
+    }
+    static char text[65536];
+    size_t len = fread (text, 1, sizeof (text) - 1, f);
+    fclose (f);
+    text[len] = 0;
+
+    static CProgram prog;
+    if (!prog.parse (text, rate, BLOCK)) {
+        printf ("%s:%u: %s\n", path, prog.errorLine (), prog.error ());
+        return 1;
+    }
+    const seq_table_t *t = prog.table ();
+    if (name) {
+        emit (t, name);
+        return 0;
+    }
+
+    // per channel summary
+    uint16_t total = 0;
+    uint32_t longest = 0;
+    const seq_step_t *steps = t->steps;
+    for (uint8_t ch = 0; ch < SEQ_CHANNELS; ++ch) {
+        uint32_t jumps = 0;
+        uint16_t last = 0;
+        uint8_t shapes = 0;
+        for (uint16_t i = 0; i < t->count[ch]; ++i) {
+            const seq_step_t &s = steps[i];
+            if (!s.ramp && (s.level != last)) ++jumps;
+            shapes |= 1 << s.shape;
+            last = s.level;
+        }
+        uint32_t blocks = prog.blocks (ch);
+        printf ("ch %u: %u segments, %.1f s, %u level jumps, shapes", ch, 
+                t->count[ch], (double) blocks * BLOCK / rate, jumps);
+        for (uint8_t i = 0; i < WAVE_SHAPES; ++i)
+            if (shapes & (1 << i)) printf (" %s", s_shapes[i]);
+        printf ("\n");
+        if (blocks > longest) longest = blocks;
+        total += t->count[ch];
+        steps += t->count[ch];
+    }
+
+    // continuous walk, then seeks compared against it
+    int failures = 0;
+    static CSequencer seq;
+    seq.load (t);
+    seq.resume ();
+    seq_out_t *trace = new seq_out_t[longest * SEQ_CHANNELS];
+    double t0 = seconds ();
+    for (uint32_t b = 0; b < longest; ++b) {
+        seq.next ();
+        for (uint8_t ch = 0; ch < SEQ_CHANNELS; ++ch)
+            trace[b * SEQ_CHANNELS + ch] = seq.out (ch);
+    }
+    double t1 = seconds ();
+    seq.next ();
+    if (!seq.finished ()) {
+        printf ("sequencer did not finish\n");
+        ++failures;
+    }
+    srand (1);
+    for (int i = 0; (i < 1000) && longest; ++i) {
+        uint32_t b = rand () % longest;
+        // seek() takes ms; pick a block the ms rounds back to
+        uint32_t ms = (uint32_t) (((uint64_t) b * BLOCK * 1000 + rate - 1) / rate);
+        b = (uint32_t) ((uint64_t) ms * rate / (BLOCK * 1000));
+        seq.seek (ms);
+        seq.next ();
+        for (uint8_t ch = 0; ch < SEQ_CHANNELS; ++ch) {
+            const seq_out_t &a = seq.out (ch), &e = trace[b * SEQ_CHANNELS + ch];
+            if ((a.level != e.level) || (e.level && ((a.inc != e.inc) 
+                || (a.shape != e.shape)))) {
+                printf ("seek to %u ms differs on ch %u\n", ms, ch);
+                ++failures;
+                break;
+            }
+        }
+    }
+    delete[] trace;
+
+    printf ("table %u bytes in flash (%u steps of %u bytes), compiler %u bytes"
+            " RAM, sequencer %u bytes RAM\n", 
+            (unsigned) (total * sizeof (seq_step_t) + sizeof (seq_table_t)),
+            total, (unsigned) sizeof (seq_step_t), (unsigned) sizeof (CProgram),
+            (unsigned) sizeof (CSequencer));
+    printf ("next() %.1f ns per block on the host, block period %.1f us\n",
+            longest ? (t1 - t0) / longest * 1e9 : 0.0, BLOCK * 1e6 / rate);
+    printf ("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
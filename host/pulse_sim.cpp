@@ -0,0 +1,183 @@
+/// @file pulse_sim.cpp
+/// @brief Run the firmware's pulse generator against a simulated PWM timer
+///        and check the captured pulse train on the host
+///
+/// The firmware's CPulseGen plays a CPulsePattern through the PWM and PDC
+/// registers of the shim. A simulated synchronous PWM channel loads one
+/// width per period from the PDC, moves to the queued pass and raises
+/// ENDTX as the hardware does, and calls CPulseGen::interrupt() to re-arm
+/// it. A simulated capture unit timestamps the edges at 42 MHz into the
+/// same CJitterStats the firmware's selfTest() uses; optional random edge
+/// displacement checks that jitter is detected.
+///
+/// The pattern loops for the given passes and then plays once more as a
+/// one-shot. Fails if a pulse is missing, the widths or the period within
+/// bursts stray from the pattern by more than the injected jitter allows,
+/// the gaps between passes are miscounted, injected jitter goes unseen,
+/// or the one-shot does not end silent.
+///
+/// Build: g++ -O2 -no-pie -fpermissive -Ishim -I../source -o pulse_sim
+///            pulse_sim.cpp ../source/pulse.cpp ../source/pulsegen.cpp
+///            shim/shim.cpp
+///        (-no-pie keeps the tables at 32-bit addresses for the PDC
+///        registers, -fpermissive lets the firmware's casts to them pass)
+/// Usage: pulse_sim width period burst gap passes [jitter_ns [tickhz]]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "Arduino.h"
+#include "pulsegen.hpp"
+
+#define CAPTURE_HZ 42000000     ///< capture clock, MCK/2
+
+/// @brief Simulated PWM channel 0 in synchronous mode fed by its PDC
+class CSimPwm {
+public:
+    CSimPwm (uint32_t tickhz, uint32_t jitter)
+    : m_tickhz (tickhz), m_jitter (jitter), m_now (0), m_duty (0) {}
+
+    /// @brief Play one period slot
+    /// @param stats  Captured pulses, or 0 to only check for silence
+    /// @return       false if the slot was not silent and stats is 0
+    bool slot (CJitterStats *stats)
+    {
+        uint32_t period = PWM->PWM_CH_NUM[0].PWM_CPRD;
+        if (!(PWM->PWM_PTCR & PERIPH_PTCR_TXTEN)) return true;
+        // the PDC loads the duty of this period, then the next buffer
+        if (PWM->PWM_TCR > 0) {
+            const uint32_t *p = (const uint32_t *) (uintptr_t) PWM->PWM_TPR;
+            m_duty = *p;
+            PWM->PWM_TPR += 4;
+            if (--PWM->PWM_TCR == 0) {
+                PWM->PWM_ISR2 |= PWM_ISR2_ENDTX;
+                if (PWM->PWM_TNCR > 0) {
+                    PWM->PWM_TPR = PWM->PWM_TNPR;
+                    PWM->PWM_TCR = PWM->PWM_TNCR;
+                    PWM->PWM_TNCR = 0;
+                }
+                CPulseGen::get ()->interrupt ();
+                PWM->PWM_ISR2 = 0;
+            }
+        }
+        bool silent = (m_duty == 0);
+        if (!silent && stats)
+            stats->add (edge (m_now), edge (m_now + m_duty));
+        m_now += period;
+        return silent || stats;
+    }
+
+protected:
+    /// @brief Convert a tick time to a capture timestamp with jitter
+    uint32_t edge (uint64_t tick) const
+    {
+        uint64_t t = tick * CAPTURE_HZ / m_tickhz;
+        if (m_jitter) t += rand () % (2 * m_jitter + 1) - m_jitter;
+        return (uint32_t) t;
+    }
+
+    uint32_t m_tickhz;      ///< PWM tick rate
+    uint32_t m_jitter;      ///< max edge displacement in capture ticks
+    uint64_t m_now;         ///< start of the current slot in ticks
+    uint32_t m_duty;        ///< duty of the current period in ticks
+};
+
+/// @brief Check a statistic against its nominal value
+static bool
+within (const char *what, double ns, uint32_t value, uint32_t nominal, uint32_t tol)
+{
+    bool ok = (value + tol >= nominal) && (value <= nominal + tol);
+    if (!ok)
+        printf ("%s %.0f ns, expected %.0f +- %.0f ns\n", what, value * ns,
+                nominal * ns, tol * ns);
+    return ok;
+}
+
+int
+main (int argc, char **argv)
+{
+    if (argc < 6) {
+        fprintf (stderr, "usage: %s width period burst gap passes [jitter_ns [tickhz]]\n", argv[0]);
+        return 2;
+    }
+    uint32_t jitter = (argc > 6) ? (uint32_t) ((uint64_t) atoi (argv[6]) * CAPTURE_HZ / 1000000000) : 0;
+    uint32_t tickhz = (argc > 7) ? atoi (argv[7]) : 1000000;
+
+    int width = atoi (argv[1]), period = atoi (argv[2]);
+    int burst = atoi (argv[3]), gapn = atoi (argv[4]), passes = atoi (argv[5]);
+    if ((period < 2) || (period > 65535)) {
+        fprintf (stderr, "period must be 2..65535 ticks\n");
+        return 2;
+    }
+    if ((width < 1) || (width >= period) || (burst < 1) || (passes < 1)) {
+        fprintf (stderr, "width must be 1..period-1, burst and passes at least 1\n");
+        return 2;
+    }
+    // static, so the PDC registers can hold its address
+    static CPulsePattern pattern;
+    pattern.begin (period);
+    if (!pattern.burst (width, burst, gapn)) {
+        fprintf (stderr, "pattern exceeds %d slots\n", PULSE_MAXSLOTS);
+        return 2;
+    }
+
+    // loop the pattern, stopping after the last pass
+    CPulseGen *gen = CPulseGen::get ();
+    CSimPwm pwm (tickhz, jitter);
+    CJitterStats stats;
+    uint32_t slot = (uint64_t) period * CAPTURE_HZ / tickhz;
+    stats.reset (slot);
+    gen->begin (tickhz);
+    gen->start (pattern, true);
+    for (int n = passes * pattern.count (); n > 0; --n)
+        pwm.slot (&stats);
+    gen->stop ();
+
+    // one pass as a one-shot: the generator must end on its own, silent
+    CJitterStats once;
+    once.reset (slot);
+    gen->start (pattern, false);
+    for (int n = pattern.count () + 1; n > 0; --n)
+        pwm.slot (&once);
+    bool ended = !gen->running ();
+    for (int n = 0; n < 3 * pattern.count (); ++n)
+        ended = pwm.slot (0) && ended;
+
+    double ns = 1e9 / CAPTURE_HZ;
+    printf ("%u pulses\n", stats.pulses ());
+    printf ("width  %.0f..%.0f ns, jitter %.0f ns\n", stats.minWidth () * ns,
+            stats.maxWidth () * ns, stats.widthJitter () * ns);
+    printf ("period mean %.0f ns, jitter %.0f ns\n", stats.meanPeriod () * ns,
+            stats.periodJitter () * ns);
+    if (stats.gaps ())
+        printf ("%u gaps, jitter %.0f ns\n", stats.gaps (), stats.gapJitter () * ns);
+    printf ("one-shot %u pulses, %s\n", once.pulses (), ended ? "ended" : "still running");
+
+    // an edge is off by at most the jitter plus one capture tick of
+    // rounding, so a width or interval by twice that and the peak-to-peak
+    // jitter by four times; within a burst the interval errors telescope
+    uint32_t nominal = (uint64_t) width * CAPTURE_HZ / tickhz;
+    uint32_t tol = 2 * (jitter + 1);
+    bool ok = true;
+    if (stats.pulses () != (uint32_t) (passes * burst) || once.pulses () != (uint32_t) burst) {
+        printf ("expected %d and %d pulses\n", passes * burst, burst);
+        ok = false;
+    }
+    ok = within ("shortest width", ns, stats.minWidth (), nominal, tol) && ok;
+    ok = within ("longest width", ns, stats.maxWidth (), nominal, tol) && ok;
+    if (burst > 1) {
+        ok = within ("mean period", ns, stats.meanPeriod (), slot, 1 + tol / (burst - 1)) && ok;
+        ok = within ("period jitter", ns, stats.periodJitter (), 0, 2 * tol) && ok;
+    }
+    uint32_t gaps = gapn ? passes - 1 : 0;
+    if (stats.gaps () != gaps) {
+        printf ("expected %u gaps\n", gaps);
+        ok = false;
+    }
+    if (jitter && (stats.widthJitter () == 0) && (stats.periodJitter () == 0)) {
+        printf ("injected jitter not detected\n");
+        ok = false;
+    }
+    ok = ended && ok;
+    printf ("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,220 @@
+/// @file safety_faults.cpp
+/// @brief Inject faults into the output safety limits on the host
+///
+/// Blocks of tagged DAC samples pass through the firmware's CSafety as in
+/// the DACC interrupt. Each case injects one fault: full-scale overshoot,
+/// steps, random garbage including tag bits, a task that stops checking 
+/// in, a held knob button, and checks that the output never leaves the 
+/// limits, that stops fade to silence and block the watchdog, and that 
+/// rearm() fades back in. Finally the per-sample cost is timed.
+///
+/// Build: g++ -O2 -I../source -o safety_faults safety_faults.cpp ../source/safety.cpp
+/// Usage: safety_faults [seed]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "safety.hpp"
+
+#define BLOCK 64                        ///< samples per channel and block
+#define BLOCKRATE (20000 / BLOCK)       ///< blocks per second
+#define TAG_MASK 0xF000                 ///< bits above the DAC code
+#define LEVEL 16384                     ///< Q15 level limit, half swing
+#define SLEW 200                        ///< DAC codes per sample
+#define CEILING ((LEVEL * (DAC_MAX - DAC_MID)) >> 15)
+
+static int s_failures = 0;
+
+static void
+check (bool ok, const char *what)
+{
+    if (!ok) {
+        printf ("%s\n", what);
+        ++s_failures;
+    }
+}
+
+/// @brief Fill a block with a per-channel function of the sample index
+static void
+fill (uint16_t *buf, uint32_t t0, int32_t (*fn) (uint32_t))
+{
+    for (uint16_t i = 0; i < BLOCK; ++i)
+        for (uint8_t ch = 0; ch < SAFE_CHANNELS; ++ch)
+            buf[i * SAFE_CHANNELS + ch] = (uint16_t) (ch << 12) 
+                | (uint16_t) (DAC_MID + fn (t0 + i));
+}
+
+static int32_t square (uint32_t t) { return (t / 50) & 1 ? -2047 : 2047; }
+static int32_t small (uint32_t t) { return (t / 50) & 1 ? -100 : 100; }
+
+/// @brief Largest deviation from DAC_MID and largest step in a block; 
+///        fails on a changed tag
+static void
+measure (const uint16_t *buf, int32_t *last, int32_t *peak, int32_t *step)
+{
+    for (uint16_t i = 0; i < BLOCK; ++i) {
+        for (uint8_t ch = 0; ch < SAFE_CHANNELS; ++ch) {
+            uint16_t s = buf[i * SAFE_CHANNELS + ch];
+            int32_t d = (int32_t) (s & DAC_MAX) - DAC_MID;
+            if (abs (d) > *peak) *peak = abs (d);
+            if (abs (d - last[ch]) > *step) *step = abs (d - last[ch]);
+            last[ch] = d;
+            if ((s & TAG_MASK) != (ch << 12)) {
+                check (false, "channel tag changed");
+                return;
+            }
+        }
+    }
+}
+
+static void
+setup (CSafety &s)
+{
+    s.configure (BLOCKRATE, 1500, 50, 200);
+    for (uint8_t ch = 0; ch < SAFE_CHANNELS; ++ch)
+        s.setLimits (ch, LEVEL, SLEW);
+}
+
+static double
+seconds ()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int
+main (int argc, char **argv)
+{
+    srand (argc > 1 ? atoi (argv[1]) : 1);
+    uint16_t buf[BLOCK * SAFE_CHANNELS];
+    uint32_t runs[2] = { 0, 0 };
+
+    // overshoot and steps: a full-scale square wave
+    {
+        CSafety s;
+        setup (s);
+        int32_t last[SAFE_CHANNELS] = { 0, 0 }, peak = 0, step = 0;
+        for (uint32_t b = 0; b < 100; ++b) {
+            fill (buf, b * BLOCK, square);
+            s.apply (buf, BLOCK);
+            measure (buf, last, &peak, &step);
+        }
+        check (peak <= CEILING, "overshoot passed the level limit");
+        check (step <= SLEW, "step passed the slew limit");
+        check (s.clamped () > 0, "clamped samples not counted");
+        printf ("square:  peak %d/%d, step %d/%d\n", peak, CEILING, step, SLEW);
+    }
+
+    // garbage: random codes with random bits above the DAC code
+    {
+        CSafety s;
+        setup (s);
+        int32_t last[SAFE_CHANNELS] = { 0, 0 }, peak = 0, step = 0;
+        for (uint32_t b = 0; b < 1000; ++b) {
+            for (uint16_t i = 0; i < BLOCK * SAFE_CHANNELS; ++i)
+                buf[i] = (uint16_t) rand ();
+            uint16_t tags[BLOCK * SAFE_CHANNELS];
+            for (uint16_t i = 0; i < BLOCK * SAFE_CHANNELS; ++i)
+                tags[i] = buf[i] & TAG_MASK;
+            s.apply (buf, BLOCK);
+            for (uint16_t i = 0; i < BLOCK * SAFE_CHANNELS; ++i) {
+                int32_t d = (int32_t) (buf[i] & DAC_MAX) - DAC_MID;
+                if (abs (d) > peak) peak = abs (d);
+                if (abs (d - last[i % SAFE_CHANNELS]) > step) 
+                    step = abs (d - last[i % SAFE_CHANNELS]);
+                last[i % SAFE_CHANNELS] = d;
+                if ((buf[i] & TAG_MASK) != tags[i]) {
+                    check (false, "garbage: upper bits changed");
+                    break;
+                }
+            }
+        }
+        check ((peak <= CEILING) && (step <= SLEW), "garbage passed the limits");
+        printf ("garbage: peak %d/%d, step %d/%d\n", peak, CEILING, step, SLEW);
+    }
+
+    // hung task: task 1 stops running after 1 s
+    {
+        CSafety s;
+        setup (s);
+        int32_t last[SAFE_CHANNELS] = { 0, 0 };
+        uint32_t fed = 0, hung = BLOCKRATE, stopped = 0, silent = 0;
+        for (uint32_t b = 0; b < 3 * BLOCKRATE; ++b) {
+            ++runs[0];
+            if (b < hung) ++runs[1];
+            fill (buf, b * BLOCK, small);
+            s.apply (buf, BLOCK);
+            int32_t peak = 0, step = 0;
+            measure (buf, last, &peak, &step);
+            check (step <= SLEW, "hung task: fade stepped");
+            bool feed = s.tick (false, runs, 2);
+            if (feed && stopped) 
+                check (false, "hung task: watchdog fed after the stop");
+            fed += feed;
+            if (!stopped && s.faults ()) stopped = b;
+            if (stopped && !silent && (peak == 0)) silent = b;
+        }
+        check (s.faults () == SAFE_TASKS, "hung task: not detected");
+        check (stopped - hung <= 2 * 200 * BLOCKRATE / 1000, 
+               "hung task: detected too late");
+        check (silent && (silent - stopped <= 50 * BLOCKRATE / 1000 + 1),
+               "hung task: fade too slow");
+        printf ("hung:    stop after %u ms, silent %u ms later, fed %u times\n",
+                (stopped - hung) * 1000 / BLOCKRATE, 
+                (silent - stopped) * 1000 / BLOCKRATE, fed);
+
+        // rearm fades back in without a step
+        s.rearm ();
+        int32_t peak = 0, step = 0;
+        for (uint32_t b = 0; b < BLOCKRATE / 5; ++b) {
+            fill (buf, b * BLOCK, small);
+            s.apply (buf, BLOCK);
+            measure (buf, last, &peak, &step);
+        }
+        check ((peak == 100) && (step <= SLEW), "rearm: no clean fade in");
+    }
+
+    // button: a click must not stop, a hold must
+    {
+        CSafety s;
+        setup (s);
+        uint32_t b = 0;
+        for (; b < BLOCKRATE; ++b) {
+            ++runs[0]; ++runs[1];
+            s.tick (b < BLOCKRATE / 2, runs, 2);
+        }
+        check (s.faults () == 0, "button: click stopped the output");
+        uint32_t held = 0;
+        for (; !s.faults () && (held < 3 * BLOCKRATE); ++b, ++held) {
+            ++runs[0]; ++runs[1];
+            s.tick (true, runs, 2);
+        }
+        check (s.faults () == SAFE_HOLD, "button: hold did not stop");
+        printf ("button:  hold stop after %u ms\n", held * 1000 / BLOCKRATE);
+    }
+
+    // cost per sample, at unity gain and during a fade
+    {
+        CSafety s;
+        setup (s);
+        const int reps = 200000;
+        fill (buf, 0, square);
+        double t0 = seconds ();
+        for (int i = 0; i < reps; ++i)
+            s.apply (buf, BLOCK);
+        double t1 = seconds ();
+        s.stop (SAFE_MANUAL);
+        for (int i = 0; i < reps; ++i) {
+            if ((i & 15) == 0) s.rearm (); else if ((i & 15) == 8) s.stop (SAFE_MANUAL);
+            s.apply (buf, BLOCK);
+        }
+        double t2 = seconds ();
+        double n = (double) reps * BLOCK * SAFE_CHANNELS;
+        printf ("apply:   %.2f ns/sample, fading %.2f ns/sample\n", 
+                (t1 - t0) / n * 1e9, (t2 - t1) / n * 1e9);
+    }
+
+    printf ("%s\n", s_failures ? "FAIL" : "PASS");
+    return s_failures ? 1 : 0;
+}
@@ -0,0 +1,182 @@
+/// @file screen_capture.cpp
+/// @brief Capture the panel stream of scripted screens on the host
+///
+/// Drives the firmware's TextFrameBuffer and widgets through a fixed
+/// script of screens, built with ST7735_CAPTURE against the Arduino
+/// stand-in in shim/, and writes every record the driver passes to its
+/// capture sink to a file in the format st7735_replay reads:
+///     kind (1 byte, @see capture_kind_t), length (2 bytes, little endian),
+///     length bytes of payload
+/// Each render() ends one frame. screen_test.sh replays the file and
+/// compares the frames with the golden images and byte budgets in golden/.
+///
+/// Afterwards, without capturing, four level meters follow noisy signals
+/// for 300 frames at 33 ms. The cells sent per frame on average must stay
+/// within METER_CELLS, else it prints FAIL and exits with 1.
+///
+/// Build: g++ -O2 -Wno-narrowing -Wno-overflow -DST7735_CAPTURE -Ishim
+///            -I../source -o screen_capture screen_capture.cpp
+///            ../source/ST7735.cpp ../source/widget.cpp shim/shim.cpp
+/// Usage: screen_capture capture.bin
+
+#include <stdio.h>
+#include "widget.hpp"
+#include "knob.hpp"
+
+#define METER_CELLS 16           ///< cell budget per frame of four meters
+#define CELL_BYTES (FONTWIDTH * FONTHEIGHT * 2)  ///< RGB565 pixels of a cell
+
+static FILE *s_out = 0;
+static unsigned s_frame = 0;   ///< frames captured, as st7735_replay counts
+
+/// @brief Capture sink writing one record per call
+static void
+sink (uint8_t kind, const uint8_t *data, uint16_t length)
+{
+    uint8_t hdr[3] = { kind, (uint8_t) length, (uint8_t) (length >> 8) };
+    fwrite (hdr, 1, 3, s_out);
+    if (length) fwrite (data, 1, length, s_out);
+}
+
+/// @brief Render a frame and report its traffic
+static void
+frame (TextFrameBuffer &tfb, const char *what)
+{
+    tfb.render ();
+    printf ("frame %3u: %6u bytes  %s\n", s_frame++,
+            (unsigned) tfb.frameBytes (), what);
+}
+
+int
+main (int argc, char **argv)
+{
+    if (argc < 2) {
+        fprintf (stderr, "usage: %s capture.bin\n", argv[0]);
+        return 2;
+    }
+    s_out = fopen (argv[1], "wb");
+    if (!s_out) {
+        perror (argv[1]);
+        return 2;
+    }
+    Adafruit_ST7735::setCapture (sink);
+
+    static TextFrameBuffer tfb;
+    tfb.configure (10, 9, 8);
+    tfb.setRotation (1);
+
+    // a status screen: frame, title, fields of every kind, gauges
+    static const field_t F_MA = field_t (7).fixed (1).unit ("mA");
+    static const field_t F_HZ = field_t (7).unit ("Hz");
+    static const field_t F_PCT = field_t (5).percent ().attr (ATTR (14, 0));
+    static const field_t F_HEX = field_t (6).hex ().zero ();
+    static const field_t F_OFS = field_t (6).plus ();
+    tfb.textAttr (ATTR (7, 0));
+    tfb.frame (0, 0, tfb.cols (), tfb.rows ());
+    tfb.textOut (2, 0, " diy box ");
+    tfb.textOut (2, 2, "ch 0");
+    tfb.textOut (2, 3, "ch 1");
+    tfb.fieldOut (7, 2, F_MA, 125);
+    tfb.fieldOut (7, 3, F_MA, -38);
+    tfb.fieldOut (15, 2, F_HZ, 80);
+    tfb.fieldOut (15, 3, F_HZ, 1200);
+    tfb.fieldOut (2, 5, F_PCT, 32768);
+    tfb.fieldOut (8, 5, F_HEX, 0xBEEF);
+    tfb.fieldOut (15, 5, F_OFS, 42);
+    tfb.hbar (2, 7, 17, 40);
+    tfb.hbar (2, 8, 40, 40);
+    tfb.bar (2, 10, tfb.cols () - 3, 11, ' ', ATTR (0, 1));
+    tfb.textOut (3, 10, "selected", 8);
+    frame (tfb, "status screen");
+
+    // one field changes: only its cells may be sent
+    tfb.fieldOut (7, 2, F_MA, 126);
+    frame (tfb, "one field");
+
+    // nothing changes: nothing may be sent but the frame end
+    frame (tfb, "idle");
+
+    // a second page drawn off screen, then shown
+    tfb.selectPage (1);
+    tfb.textAttr (ATTR (15, 4));
+    tfb.bar (0, 0, tfb.cols (), tfb.rows (), ' ', ATTR (15, 4));
+    tfb.textOut (4, 7, "OUTPUT STOPPED");
+    tfb.showPage (1);
+    frame (tfb, "alert page");
+
+    // back to the status page
+    tfb.showPage (0);
+    tfb.selectPage (0);
+    frame (tfb, "status page again");
+
+    // widgets on a screen, with the focus on the editable number
+    static volatile int32_t level = 600, freq = 80;
+    static CLabel title (1, 1, 10, "settings", ATTR (11, 0));
+    static CNumber number (1, 3, field_t (7).unit ("Hz"), &freq, ATTR (7, 0));
+    static CGauge gauge (1, 5, 20, &level, 1000, ATTR (10, 0));
+    static CScreen screen (ATTR (0, 7), ATTR (0, 14));
+    number.setRange (1, 2000, 1);
+    screen.add (title);
+    screen.add (number);
+    screen.add (gauge);
+    screen.focus (&number);
+    tfb.bar (0, 0, tfb.cols (), tfb.rows (), ' ', ATTR (7, 0));
+    screen.update (&tfb);
+    frame (tfb, "widgets");
+
+    // a push captures the knob, turns edit the number
+    screen.input (CKnob::BIT_PUSH, 1, 0);
+    screen.input (CKnob::BIT_RIGHT, 0, 5);
+    level = 250;
+    screen.update (&tfb);
+    frame (tfb, "widget edit");
+
+    // portrait rotation redraws the whole panel
+    tfb.setRotation (0);
+    tfb.textAttr (ATTR (7, 0));
+    tfb.bar (0, 0, tfb.cols (), tfb.rows (), ' ', ATTR (7, 0));
+    tfb.frame (0, 0, tfb.cols (), tfb.rows ());
+    tfb.textOut (2, 1, "portrait");
+    tfb.fieldOut (2, 3, F_MA, 999);
+    frame (tfb, "portrait");
+
+    // four meters with peak markers
+    static volatile int32_t levels[4] = { 250, 500, 750, 1000 };
+    static CMeter *meters[4];
+    static CScreen mscreen (ATTR (0, 7), ATTR (0, 14));
+    tfb.setRotation (1);
+    tfb.bar (0, 0, tfb.cols (), tfb.rows (), ' ', ATTR (7, 0));
+    for (uint8_t i = 0; i < 4; ++i) {
+        meters[i] = new CMeter (2, 2 + 3 * i, 20, &levels[i], 1000, i, ATTR (10, 0));
+        meters[i]->setPeak (500, 2000);
+        mscreen.add (*meters[i]);
+    }
+    mscreen.update (&tfb);
+    levels[0] = 100;
+    shim_ms += 100;
+    mscreen.update (&tfb);
+    frame (tfb, "meters");
+    fclose (s_out);
+    Adafruit_ST7735::setCapture (0);
+
+    // the meters' cell budget over signals sweeping up and down with noise
+    uint64_t bytes = 0;
+    uint32_t most = 0, noise = 1;
+    for (int f = 0; f < 300; ++f) {
+        shim_ms += 33;
+        for (int i = 0; i < 4; ++i) {
+            int32_t t = (f * 7 * (i + 1)) % 1600;
+            noise = noise * 1103515245 + 12345;
+            levels[i] = 100 + ((t < 800) ? t : 1600 - t) + (int32_t) ((noise >> 16) % 41) - 20;
+        }
+        mscreen.update (&tfb);
+        tfb.render ();
+        bytes += tfb.frameBytes ();
+        if (tfb.frameBytes () > most) most = tfb.frameBytes ();
+    }
+    double cells = (double) bytes / 300 / CELL_BYTES;
+    bool ok = cells <= METER_CELLS;
+    printf ("meters: %.1f cells per frame, at most %u, budget %u\n%s\n", cells,
+            (unsigned) (most / CELL_BYTES), METER_CELLS, ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
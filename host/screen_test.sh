@@ -0,0 +1,38 @@
+#!/bin/sh
+# @file screen_test.sh
+# @brief Build screen_capture and st7735_replay, capture the scripted
+#        screens and compare them with the golden images and byte budget
+#
+# Usage: screen_test.sh [--update]
+#        --update rewrites golden/screen-NNN.ppm from the current firmware;
+#        golden/screen.budget is kept up to date by hand
+
+set -e
+here=$(cd "$(dirname "$0")" && pwd)
+work=${TMPDIR:-/tmp}/screen_test
+mkdir -p "$work"
+rm -f "$work"/*.ppm
+
+cd "$here"
+g++ -O2 -Wno-narrowing -Wno-overflow -DST7735_CAPTURE -Ishim -I../source \
+    -o "$work/screen_capture" screen_capture.cpp \
+    ../source/ST7735.cpp ../source/widget.cpp shim/shim.cpp
+g++ -O2 -o "$work/st7735_replay" st7735_replay.cpp
+
+if ! "$work/screen_capture" "$work/capture.bin"; then
+    echo FAIL
+    exit 1
+fi
+if [ "$1" = "--update" ]; then
+    rm -f golden/screen-*.ppm
+    "$work/st7735_replay" "$work/capture.bin" golden/screen
+    echo "golden images updated"
+    exit 0
+fi
+if "$work/st7735_replay" "$work/capture.bin" "$work/screen" golden/screen \
+    golden/screen.budget; then
+    echo PASS
+else
+    echo FAIL
+    exit 1
+fi
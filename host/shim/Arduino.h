@@ -0,0 +1,71 @@
+/// @file Arduino.h
+/// @brief Host stand-in for the Arduino Due core, covering what the display
+///        driver, the widgets, the knob header, the telemetry and the
+///        pulse generator use, @see chip.h for the latter. Pins and
+///        registers are plain memory, millis() returns shim_ms and delay()
+///        advances it.
+
+#ifndef _SHIM_ARDUINO_H_
+#define _SHIM_ARDUINO_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "variant.h"
+#include "chip.h"
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define CHANGE 2
+
+typedef uint8_t byte;
+
+/// @brief PIO controller registers used by the drivers
+struct Pio {
+    volatile uint32_t PIO_PDSR, PIO_CODR, PIO_SODR, PIO_IFER, PIO_DIFSR, 
+                      PIO_SCDR;
+};
+
+/// @brief Cortex-M3 debug registers used by cycles.hpp
+struct CoreDebug_Type { volatile uint32_t DEMCR; };
+struct DWT_Type { volatile uint32_t CTRL, CYCCNT; };
+extern CoreDebug_Type *CoreDebug;
+extern DWT_Type *DWT;
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+#define DWT_CTRL_CYCCNTENA_Msk 1UL
+
+extern uint32_t shim_ms;        ///< time returned by millis()
+
+Pio *digitalPinToPort (uint32_t pin);
+uint32_t digitalPinToBitMask (uint32_t pin);
+void pinMode (uint32_t pin, uint32_t mode);
+void digitalWrite (uint32_t pin, uint32_t value);
+void attachInterrupt (uint32_t pin, void (*fn) (), uint32_t mode);
+void delay (uint32_t ms);
+uint32_t millis ();
+uint32_t micros ();
+
+inline void __WFI () {}
+
+/// @brief Stand-in for the native USB serial port. The host opens it with
+///        shim_usb_open and receives the bytes written through
+///        shim_usb_write, which may take fewer than offered.
+class Serial_ {
+public:
+    void begin (uint32_t) {}
+    size_t write (const uint8_t *data, size_t n);
+    operator bool () const;
+};
+extern Serial_ SerialUSB;
+extern bool shim_usb_open;      ///< a host has the port open
+extern size_t (*shim_usb_write) (const uint8_t *data, size_t n);
+                                ///< receiver of written bytes, or 0 to drop
+
+#define constrain(x, lo, hi) ((x) < (lo) ? (lo) : ((x) > (hi) ? (hi) : (x)))
+template <class T> inline T min (T a, T b) { return (a < b) ? a : b; }
+template <class T> inline T max (T a, T b) { return (a > b) ? a : b; }
+
+#endif // _SHIM_ARDUINO_H_
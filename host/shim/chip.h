@@ -0,0 +1,80 @@
+/// @file chip.h
+/// @brief Host stand-in for the SAM3X registers and peripheral library
+///        calls pulsegen.cpp uses. The registers are plain memory that a
+///        host model reads and writes, e.g. pulse_sim's PWM and PDC; the
+///        PDC pointer registers hold 32-bit addresses, so such a model
+///        is built without PIE to keep static tables below 4 GB.
+
+#ifndef _SHIM_CHIP_H_
+#define _SHIM_CHIP_H_
+
+#include <stdint.h>
+
+struct Pio;
+
+/// @brief PWM controller with its PDC channel
+struct Pwm {
+    volatile uint32_t PWM_CLK, PWM_ENA, PWM_DIS, PWM_SCM, PWM_SCUC, PWM_SCUP;
+    volatile uint32_t PWM_IER2, PWM_IDR2, PWM_ISR2;
+    volatile uint32_t PWM_TPR, PWM_TCR, PWM_TNPR, PWM_TNCR, PWM_PTCR;
+    struct {
+        volatile uint32_t PWM_CMR, PWM_CDTY, PWM_CDTYUPD, PWM_CPRD;
+    } PWM_CH_NUM[8];
+};
+
+/// @brief Timer counter block
+struct Tc {
+    struct {
+        volatile uint32_t TC_CMR, TC_IER, TC_SR, TC_RA, TC_RB;
+    } TC_CHANNEL[3];
+};
+
+extern Pwm *PWM;
+extern Tc *TC2;
+
+#define PWM_ISR2_ENDTX          (1UL << 1)
+#define PWM_IER2_ENDTX          (1UL << 1)
+#define PWM_IDR2_ENDTX          (1UL << 1)
+#define PWM_ENA_CHID0           (1UL << 0)
+#define PWM_DIS_CHID0           (1UL << 0)
+#define PWM_CLK_PREA(x)         ((uint32_t) (x) << 8)
+#define PWM_CLK_DIVA(x)         ((uint32_t) (x))
+#define PWM_SCM_SYNC0           (1UL << 0)
+#define PWM_SCM_UPDM_MODE2      (2UL << 16)
+#define PWM_SCUP_UPR(x)         ((uint32_t) (x))
+#define PWM_SCUC_UPDULOCK       (1UL << 0)
+#define PWM_CMR_CPRE_CLKA       (11UL << 0)
+#define PWM_CMR_CPOL            (1UL << 9)
+#define PERIPH_PTCR_TXTEN       (1UL << 8)
+#define PERIPH_PTCR_TXTDIS      (1UL << 9)
+
+#define TC_SR_LDRBS             (1UL << 6)
+#define TC_IER_LDRBS            (1UL << 6)
+#define TC_CMR_TCCLKS_TIMER_CLOCK1  (0UL << 0)
+#define TC_CMR_LDRA_RISING      (1UL << 16)
+#define TC_CMR_LDRB_FALLING     (2UL << 18)
+
+enum IRQn_Type { PWM_IRQn = 36, TC6_IRQn = 33 };
+#define ID_PWM 36
+#define ID_TC6 33
+
+#define PIO_PERIPH_B 2
+#define PIO_DEFAULT 0
+
+/// @brief Pin description of the variant
+struct PinDescription {
+    Pio *pPort;
+    uint32_t ulPin;
+};
+extern const PinDescription g_APinDescription[];
+
+void pmc_enable_periph_clk (uint32_t id);
+void PIO_Configure (Pio *pio, uint32_t type, uint32_t mask, uint32_t attr);
+void TC_Configure (Tc *tc, uint32_t ch, uint32_t mode);
+void TC_Start (Tc *tc, uint32_t ch);
+void TC_Stop (Tc *tc, uint32_t ch);
+void NVIC_SetPriority (IRQn_Type irq, uint32_t prio);
+void NVIC_EnableIRQ (IRQn_Type irq);
+void NVIC_DisableIRQ (IRQn_Type irq);
+
+#endif // _SHIM_CHIP_H_
@@ -0,0 +1,2 @@
+/// @file pio.h
+/// @brief Host stand-in, the PIO registers are in Arduino.h
@@ -0,0 +1,2 @@
+/// @file pins_arduino.h
+/// @brief Host stand-in, empty
@@ -0,0 +1,61 @@
+/// @file shim.cpp
+/// @brief Host stand-in for the Arduino Due core and the SPI driver. The 
+///        panel bytes reach the host through the driver's capture sink,
+///        @see Adafruit_ST7735::setCapture(), so SPI only drops them.
+
+#include "Arduino.h"
+#include "SPI.hpp"
+
+uint32_t shim_ms = 0;
+
+static Pio s_pio;
+static CoreDebug_Type s_coredebug;
+static DWT_Type s_dwt;
+CoreDebug_Type *CoreDebug = &s_coredebug;
+DWT_Type *DWT = &s_dwt;
+
+static Pwm s_pwm;
+static Tc s_tc2;
+Pwm *PWM = &s_pwm;
+Tc *TC2 = &s_tc2;
+const PinDescription g_APinDescription[80] = {};
+
+void pmc_enable_periph_clk (uint32_t) {}
+void PIO_Configure (Pio *, uint32_t, uint32_t, uint32_t) {}
+void TC_Configure (Tc *, uint32_t, uint32_t) {}
+void TC_Start (Tc *, uint32_t) {}
+void TC_Stop (Tc *, uint32_t) {}
+void NVIC_SetPriority (IRQn_Type, uint32_t) {}
+void NVIC_EnableIRQ (IRQn_Type) {}
+void NVIC_DisableIRQ (IRQn_Type) {}
+
+Pio *digitalPinToPort (uint32_t) { return &s_pio; }
+uint32_t digitalPinToBitMask (uint32_t pin) { return 1UL << (pin & 31); }
+void pinMode (uint32_t, uint32_t) {}
+void digitalWrite (uint32_t, uint32_t) {}
+void attachInterrupt (uint32_t, void (*) (), uint32_t) {}
+void delay (uint32_t ms) { shim_ms += ms; }
+uint32_t millis () { return shim_ms; }
+uint32_t micros () { return shim_ms * 1000; }
+
+Serial_ SerialUSB;
+bool shim_usb_open = false;
+size_t (*shim_usb_write) (const uint8_t *, size_t) = 0;
+
+size_t Serial_::write (const uint8_t *data, size_t n) { return shim_usb_write ? shim_usb_write (data, n) : n; }
+Serial_::operator bool () const { return shim_usb_open; }
+
+SPIClass SPI (0, 0, 0, 0);
+
+SPIClass::SPIClass (Spi *_spi, uint32_t _id, uint8_t _pin, uint8_t _dma)
+: spi (_spi), id (_id), pin (_pin), dma (_dma), initialized (false), 
+  sleeping (false)
+{
+}
+
+byte SPIClass::transfer (uint8_t, SPITransferMode) { return 0; }
+byte SPIClass::transferBuffer (uint8_t *, uint16_t) { return 0; }
+byte SPIClass::waitForDMA () { return 0; }
+void SPIClass::sendBufferDMA (const uint8_t *, uint16_t) {}
+void SPIClass::begin () { initialized = true; }
+void SPIClass::end () { initialized = false; }
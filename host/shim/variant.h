@@ -0,0 +1,21 @@
+/// @file variant.h
+/// @brief Host stand-in for the board variant: panel geometry and SPI
+
+#ifndef _SHIM_VARIANT_H_
+#define _SHIM_VARIANT_H_
+
+#include <stdint.h>
+
+#define VARIANT_MCK 84000000    ///< master clock in Hz
+
+#define ST7735_TFTWIDTH   160   ///< panel width in landscape
+#define ST7735_TFTHEIGHT  128   ///< panel height in landscape
+#define ST7735_SCRWIDTH   26    ///< text columns in landscape
+#define ST7735_SCRHEIGHT  16    ///< text rows in landscape
+
+typedef uint8_t byte;
+
+/// @brief SPI controller, never touched on the host
+struct Spi { volatile uint32_t SPI_SR; };
+
+#endif // _SHIM_VARIANT_H_
@@ -0,0 +1,2 @@
+/// @file wiring_private.h
+/// @brief Host stand-in, empty
@@ -0,0 +1,269 @@
+/// @file st7735_replay.cpp
+/// @brief Host-side ST7735 panel model replaying a captured SPI stream
+///
+/// Replays a stream recorded through Adafruit_ST7735::setCapture() into a
+/// model of the panel RAM and writes every rendered frame as a binary PPM.
+/// Optionally compares each frame against golden images and fails if a
+/// frame differs or sends more bytes than allowed. The limit is either a
+/// number for all frames or a budget file with one limit per line for
+/// frames 0, 1, ...; text after a '#' is a comment, frames beyond the last
+/// line are not limited.
+///
+/// Capture file format: a sequence of records, each being
+///     kind (1 byte, @see capture_kind_t), length (2 bytes, little endian),
+///     length bytes of payload
+///
+/// Build: g++ -O2 -o st7735_replay st7735_replay.cpp
+/// Usage: st7735_replay capture.bin outprefix [goldenprefix [maxbytes|budgetfile]]
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum capture_kind_t { CAPTURE_COMMAND = 0, CAPTURE_DATA = 1, CAPTURE_FRAME = 2 };
+
+/// @brief Behavioural model of the ST7735 memory interface
+class CPanelModel {
+public:
+    enum { RAMWIDTH = 128, RAMHEIGHT = 160 };
+
+    CPanelModel ()
+    : m_cmd (0), m_nargs (0), m_madctl (0), m_colmod (0x05), m_sleep (true),
+      m_idle (false), m_on (false), m_partial (false), m_c (0), m_r (0), m_hi (-1)
+    {
+        m_ptl[0] = 0; m_ptl[1] = RAMHEIGHT-1;
+        memset (m_ram, 0, sizeof (m_ram));
+        m_win[0] = 0; m_win[1] = RAMWIDTH-1;
+        m_win[2] = 0; m_win[3] = RAMHEIGHT-1;
+    }
+
+    /// @brief Feed a command byte
+    void command (uint8_t c)
+    {
+        m_cmd = c;
+        m_nargs = 0;
+        m_hi = -1;
+        switch (c) {
+        case 0x01: *this = CPanelModel (); break;          // SWRESET
+        case 0x10: m_sleep = true; break;                   // SLPIN
+        case 0x11: m_sleep = false; break;                  // SLPOUT
+        case 0x28: m_on = false; break;                     // DISPOFF
+        case 0x29: m_on = true; break;                      // DISPON
+        case 0x38: m_idle = false; break;                   // IDMOFF
+        case 0x39: m_idle = true; break;                    // IDMON
+        case 0x12: m_partial = true; break;                 // PTLON
+        case 0x13: m_partial = false; break;                // NORON
+        case 0x2C: m_c = m_win[0]; m_r = m_win[2]; break;   // RAMWR
+        }
+    }
+
+    /// @brief Feed a data byte
+    void data (uint8_t d)
+    {
+        switch (m_cmd) {
+        case 0x2A:  // CASET
+        case 0x2B:  // RASET
+            if (m_nargs < 4) m_args[m_nargs++] = d;
+            if (m_nargs == 4) {
+                uint16_t *w = m_win + ((m_cmd == 0x2A) ? 0 : 2);
+                w[0] = (m_args[0] << 8) | m_args[1];
+                w[1] = (m_args[2] << 8) | m_args[3];
+            }
+            break;
+        case 0x30:  // PTLAR
+            if (m_nargs < 4) m_args[m_nargs++] = d;
+            if (m_nargs == 4) {
+                m_ptl[0] = (m_args[0] << 8) | m_args[1];
+                m_ptl[1] = (m_args[2] << 8) | m_args[3];
+            }
+            break;
+        case 0x36: m_madctl = d; break;     // MADCTL
+        case 0x3A: m_colmod = d; break;     // COLMOD
+        case 0x2C:                          // RAMWR, RGB565 high byte first
+            if (m_hi < 0) {
+                m_hi = d;
+                break;
+            }
+            pixel ((m_hi << 8) | d);
+            m_hi = -1;
+            break;
+        }
+    }
+
+    /// @brief Width of the image as seen through the current MADCTL
+    int width () const { return (m_madctl & 0x20) ? RAMHEIGHT : RAMWIDTH; }
+
+    /// @brief Height of the image as seen through the current MADCTL
+    int height () const { return (m_madctl & 0x20) ? RAMWIDTH : RAMHEIGHT; }
+
+    /// @brief Get the RGB565 color shown at a logical coordinate
+    uint16_t shown (int c, int r) const
+    {
+        if (!m_on || m_sleep) return 0;
+        int a = addr (c, r);
+        // partial mode drives gate rows m_ptl[0]..m_ptl[1] only
+        if (m_partial && ((a / RAMWIDTH < m_ptl[0]) || (a / RAMWIDTH > m_ptl[1]))) return 0;
+        uint16_t color = m_ram[a];
+        // idle mode shows the MSB of each component only
+        if (m_idle) color = ((color & 0x8000) ? 0xF800 : 0) 
+                          | ((color & 0x0400) ? 0x07E0 : 0) 
+                          | ((color & 0x0010) ? 0x001F : 0);
+        return color;
+    }
+
+    /// @brief Write the shown image as a binary PPM
+    bool writePPM (const char *path) const
+    {
+        FILE *f = fopen (path, "wb");
+        if (!f) return false;
+        fprintf (f, "P6\n%d %d\n255\n", width (), height ());
+        for (int r = 0; r < height (); ++r)
+            for (int c = 0; c < width (); ++c) {
+                uint16_t color = shown (c, r);
+                uint8_t rgb[3] = { (uint8_t) ((color >> 8) & 0xF8),
+                                   (uint8_t) ((color >> 3) & 0xFC),
+                                   (uint8_t) ((color << 3) & 0xF8) };
+                fwrite (rgb, 1, 3, f);
+            }
+        fclose (f);
+        return true;
+    }
+
+protected:
+    /// @brief Map a logical column/row to a RAM index according to MADCTL
+    int addr (int c, int r) const
+    {
+        int x = c, y = r;
+        if (m_madctl & 0x20) { x = r; y = c; }          // MV
+        if (m_madctl & 0x40) x = RAMWIDTH-1 - x;         // MX
+        if (m_madctl & 0x80) y = RAMHEIGHT-1 - y;        // MY
+        if ((x < 0) || (x >= RAMWIDTH) || (y < 0) || (y >= RAMHEIGHT)) return 0;
+        return y * RAMWIDTH + x;
+    }
+
+    void pixel (uint16_t color)
+    {
+        if ((m_c < width ()) && (m_r < height ()))
+            m_ram[addr (m_c, m_r)] = color;
+        if (++m_c > m_win[1]) {
+            m_c = m_win[0];
+            if (++m_r > m_win[3]) m_r = m_win[2];
+        }
+    }
+
+    uint16_t m_ram[RAMWIDTH*RAMHEIGHT];
+    uint16_t m_win[4];      ///< column start/end, row start/end
+    uint16_t m_ptl[2];      ///< partial area start/end row
+    uint8_t  m_args[4];
+    uint8_t  m_cmd;
+    uint8_t  m_nargs;
+    uint8_t  m_madctl;
+    uint8_t  m_colmod;
+    bool     m_sleep;
+    bool     m_idle;
+    bool     m_on;
+    bool     m_partial;
+    int      m_c, m_r;      ///< RAMWR address counters
+    int      m_hi;          ///< pending high byte of a pixel, or -1
+};
+
+/// @brief Compare two binary PPM files byte by byte
+static bool
+samePPM (const char *a, const char *b)
+{
+    FILE *fa = fopen (a, "rb"), *fb = fopen (b, "rb");
+    bool same = (fa != 0) && (fb != 0);
+    while (same) {
+        int ca = fgetc (fa), cb = fgetc (fb);
+        if (ca != cb) same = false;
+        if (ca == EOF) break;
+    }
+    if (fa) fclose (fa);
+    if (fb) fclose (fb);
+    return same;
+}
+
+/// @brief Read a budget file, one byte limit per frame
+/// @return number of limits read, or -1 if the file cannot be opened
+static int
+readBudget (const char *fn, long *limits, int size)
+{
+    FILE *f = fopen (fn, "r");
+    if (!f) return -1;
+    char line[256];
+    int n = 0;
+    while ((n < size) && fgets (line, sizeof (line), f)) {
+        char *end, *p = line;
+        long v = strtol (p, &end, 10);
+        while ((*end == ' ') || (*end == '\t')) ++end;
+        if ((end == p) || ((*end != '#') && (*end != '\n') && *end)) continue;
+        limits[n++] = v;
+    }
+    fclose (f);
+    return n;
+}
+
+int
+main (int argc, char **argv)
+{
+    if (argc < 3) {
+        fprintf (stderr, "usage: %s capture.bin outprefix [goldenprefix [maxbytes|budgetfile]]\n", argv[0]);
+        return 2;
+    }
+    FILE *in = fopen (argv[1], "rb");
+    if (!in) {
+        perror (argv[1]);
+        return 2;
+    }
+    const char *golden = (argc > 3) ? argv[3] : 0;
+    static long limits[4096];
+    int nlimits = 0;
+    long maxbytes = 0;
+    if ((argc > 4) && ((argv[4][0] < '0') || (argv[4][0] > '9'))) {
+        nlimits = readBudget (argv[4], limits, sizeof (limits) / sizeof (limits[0]));
+        if (nlimits < 0) {
+            perror (argv[4]);
+            return 2;
+        }
+    } else if (argc > 4) {
+        maxbytes = atol (argv[4]);
+    }
+
+    static CPanelModel panel;
+    static uint8_t payload[65536];
+    unsigned frame = 0, failures = 0;
+    long bytes = 0;
+    uint8_t hdr[3];
+    while (fread (hdr, 1, 3, in) == 3) {
+        uint16_t length = hdr[1] | (hdr[2] << 8);
+        if (fread (payload, 1, length, in) != length) break;
+        bytes += length;
+        if (hdr[0] == CAPTURE_COMMAND) {
+            for (uint16_t i = 0; i < length; ++i) panel.command (payload[i]);
+        } else if (hdr[0] == CAPTURE_DATA) {
+            for (uint16_t i = 0; i < length; ++i) panel.data (payload[i]);
+        } else if (hdr[0] == CAPTURE_FRAME) {
+            char out[1024], ref[1024];
+            snprintf (out, sizeof (out), "%s-%03u.ppm", argv[2], frame);
+            panel.writePPM (out);
+            bool ok = true;
+            if (golden) {
+                snprintf (ref, sizeof (ref), "%s-%03u.ppm", golden, frame);
+                ok = samePPM (out, ref);
+            }
+            // a budget line applies even when 0, e.g. to a frame with no change
+            long limit = ((int) frame < nlimits) ? limits[frame] : maxbytes ? maxbytes : -1;
+            if ((limit >= 0) && (bytes > limit)) ok = false;
+            if (limit >= 0)
+                printf ("frame %3u: %6ld bytes of %6ld %s\n", frame, bytes, limit, ok ? "ok" : "FAIL");
+            else
+                printf ("frame %3u: %6ld bytes %s\n", frame, bytes, ok ? "ok" : "FAIL");
+            failures += ok ? 0 : 1;
+            bytes = 0;
+            ++frame;
+        }
+    }
+    fclose (in);
+    return failures ? 1 : 0;
+}
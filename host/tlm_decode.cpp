@@ -0,0 +1,309 @@
+/// @file tlm_decode.cpp
+/// @brief Decode the telemetry stream of the USB serial port on the host
+///        and reconstruct the mirrored text screen
+///
+/// Reads a serial device (put into raw mode) or standard input, decodes
+/// frames with the firmware's CTlmDecoder and repaints the text screen 
+/// and channel levels whenever the stream pauses. The self-test encodes 
+/// random cell updates with the firmware's CTlmRing, sends them through
+/// a pseudo-terminal with junk between frames, and compares the decoded
+/// screen to the reference. It then mirrors the firmware's TextFrameBuffer
+/// through CTelemetry over the shim's SerialUSB, rotates the screen while
+/// a frame is half sent, and compares the decoded screen to the panel's.
+///
+/// Build: g++ -O2 -Wno-narrowing -Wno-overflow -Ishim -I../source
+///            -o tlm_decode tlm_decode.cpp ../source/tlmproto.cpp
+///            ../source/telemetry.cpp ../source/ST7735.cpp
+///            ../source/wavegen.cpp ../source/modulate.cpp shim/shim.cpp
+/// Usage: tlm_decode /dev/ttyACM0 | - | --selftest [frames [seed]]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include "tlmproto.hpp"
+#include "telemetry.hpp"
+#include "synth.hpp"
+#include "power.hpp"
+
+#define MAXCOLS 64              ///< largest grid width accepted
+#define MAXROWS 32              ///< largest grid height accepted
+
+// telemetry.cpp reads the synth and power singletons for channel frames
+// only, which the self-test does not ask for; construct them empty
+CSynth::CSynth () {}
+CSynth CSynth::s_singleton;
+CPower::CPower () {}
+CPower CPower::s_singleton;
+
+/// @brief Text screen rebuilt from TLM_SCREEN and TLM_CELLS frames
+struct screen_t {
+    uint8_t cell[MAXROWS][MAXCOLS][2];  ///< character and attribute
+    int cols, rows;                     ///< grid size
+    uint16_t level[8];                  ///< last channel levels
+    int nlevels;                        ///< number of channel levels
+    uint32_t ms;                        ///< time of the channel frame
+    uint8_t state;                      ///< device state
+    uint32_t frames;                    ///< frames decoded
+    bool changed;                       ///< repaint pending
+};
+
+static void
+clear (screen_t &s, int cols, int rows)
+{
+    s.cols = cols < MAXCOLS ? cols : MAXCOLS;
+    s.rows = rows < MAXROWS ? rows : MAXROWS;
+    for (int y = 0; y < MAXROWS; ++y)
+        for (int x = 0; x < MAXCOLS; ++x) {
+            s.cell[y][x][0] = ' ';
+            s.cell[y][x][1] = 0;
+        }
+}
+
+/// @brief Frame sink updating the screen
+static void
+frame (uint8_t type, uint8_t, const uint8_t *body, uint16_t len, void *arg)
+{
+    screen_t &s = *(screen_t *) arg;
+    ++s.frames;
+    s.changed = true;
+    switch (type) {
+    case TLM_SCREEN:
+        if (len >= 2) clear (s, body[0], body[1]);
+        break;
+    case TLM_CELLS:
+        for (uint16_t i = 0; i + 3 <= len; ) {
+            int y = body[i], x = body[i+1], n = body[i+2];
+            i += 3;
+            for (int k = 0; k < n && i + 2 <= len; ++k, i += 2)
+                if ((y < MAXROWS) && (x + k < MAXCOLS)) {
+                    s.cell[y][x+k][0] = body[i];
+                    s.cell[y][x+k][1] = body[i+1];
+                }
+        }
+        break;
+    case TLM_CHANNELS:
+        if (len < 6) break;
+        memcpy (&s.ms, body, 4);
+        s.state = body[4];
+        s.nlevels = body[5] < 8 ? body[5] : 8;
+        for (int i = 0; i < s.nlevels && 6 + 2 * i + 2 <= len; ++i)
+            s.level[i] = body[6 + 2*i] | (body[7 + 2*i] << 8);
+        break;
+    }
+}
+
+static void
+paint (const screen_t &s, const CTlmDecoder &d)
+{
+    // home the cursor so the screen repaints in place
+    printf ("\033[H+");
+    for (int x = 0; x < s.cols; ++x) putchar ('-');
+    printf ("+\n");
+    for (int y = 0; y < s.rows; ++y) {
+        putchar ('|');
+        for (int x = 0; x < s.cols; ++x) {
+            uint8_t c = s.cell[y][x][0];
+            putchar ((c >= 32 && c < 127) ? c : '#');
+        }
+        printf ("|\n");
+    }
+    printf ("+");
+    for (int x = 0; x < s.cols; ++x) putchar ('-');
+    printf ("+\n%10u ms  state %u  levels", s.ms, s.state);
+    for (int i = 0; i < s.nlevels; ++i) printf (" %5u", s.level[i]);
+    printf ("\nframes %u  bad %u  lost %u\033[K\n", s.frames, d.errors (), 
+            d.lost ());
+    fflush (stdout);
+}
+
+static int
+monitor (const char *path)
+{
+    int fd = 0;
+    if (strcmp (path, "-")) {
+        fd = open (path, O_RDONLY | O_NOCTTY);
+        if (fd < 0) {
+            perror (path);
+            return 2;
+        }
+        struct termios t;
+        if (tcgetattr (fd, &t) == 0) {
+            cfmakeraw (&t);
+            tcsetattr (fd, TCSANOW, &t);
+        }
+    }
+    static screen_t s;
+    clear (s, 0, 0);
+    CTlmDecoder d (frame, &s);
+    printf ("\033[2J");
+    for (;;) {
+        struct pollfd p = { fd, POLLIN, 0 };
+        if (poll (&p, 1, 100) == 0) {
+            if (s.changed) paint (s, d);
+            s.changed = false;
+            continue;
+        }
+        uint8_t buf[512];
+        ssize_t n = read (fd, buf, sizeof (buf));
+        if (n <= 0) break;
+        for (ssize_t i = 0; i < n; ++i) d.put (buf[i]);
+    }
+    paint (s, d);
+    return 0;
+}
+
+/// @brief Send all queued ring bytes through the pty and decode them
+static void
+pump (CTlmRing &ring, int master, int slave, CTlmDecoder &d)
+{
+    const uint8_t *data;
+    uint16_t n;
+    while ((n = ring.peek (&data)) > 0) {
+        ssize_t w = write (master, data, n);
+        if (w > 0) ring.consume (w);
+        uint8_t buf[4096];
+        ssize_t r;
+        while ((r = read (slave, buf, sizeof (buf))) > 0)
+            for (ssize_t i = 0; i < r; ++i) d.put (buf[i]);
+    }
+}
+
+static CTlmDecoder *s_usb;      ///< decoder of the shim's SerialUSB
+
+/// @brief Receive what CTelemetry writes to SerialUSB
+static size_t
+usb_write (const uint8_t *data, size_t n)
+{
+    for (size_t i = 0; i < n; ++i) s_usb->put (data[i]);
+    return n;
+}
+
+/// @brief Mirror a screen through CTelemetry, rotate it while a frame is
+///        half sent, and compare the receiver's screen with the panel's
+static bool
+mirror ()
+{
+    static screen_t s;
+    static TextFrameBuffer tfb;
+    CTlmDecoder d (frame, &s);
+    clear (s, 0, 0);
+    s_usb = &d;
+    shim_usb_write = usb_write;
+    tfb.configure (10, 9, 8);
+    tfb.setRotation (1);
+    CTelemetry::get ()->begin (&tfb, 0);
+
+    // a full screen queues cell frames longer than one TLM_CHUNK write
+    for (coord_t y = 0; y < tfb.rows (); ++y)
+        for (coord_t x = 0; x < tfb.cols (); ++x)
+            tfb.putChAt (x, y, 'A' + (x + y) % 26, ATTR (7, 0));
+    tfb.render ();
+    shim_usb_open = true;
+    CTelemetry::get ()->poll ();
+
+    // rotate with the rest of that frame still queued
+    tfb.setRotation (0);
+    tfb.textOut (1, 1, "portrait");
+    tfb.render ();
+    for (int i = 0; i < 100; ++i) CTelemetry::get ()->poll ();
+
+    int bad = 0;
+    for (coord_t y = 0; y < tfb.rows (); ++y)
+        bad += memcmp (s.cell[y], tfb.shownRow (y), 2 * tfb.cols ()) != 0;
+    bool ok = (bad == 0) && (s.cols == tfb.cols ()) && (s.rows == tfb.rows ());
+    printf ("mirror: %u frames decoded, %u cut short, grid %dx%d of %dx%d, %d rows differ\n",
+            s.frames, d.errors (), s.cols, s.rows, tfb.cols (), tfb.rows (), bad);
+    shim_usb_open = false;
+    shim_usb_write = 0;
+    return ok;
+}
+
+static int
+selftest (uint32_t frames)
+{
+    int master = posix_openpt (O_RDWR | O_NOCTTY);
+    if ((master < 0) || grantpt (master) || unlockpt (master)) {
+        perror ("posix_openpt");
+        return 2;
+    }
+    int slave = open (ptsname (master), O_RDWR | O_NOCTTY | O_NONBLOCK);
+    struct termios t;
+    tcgetattr (slave, &t);
+    cfmakeraw (&t);
+    tcsetattr (slave, TCSANOW, &t);
+
+    static screen_t s, ref;
+    static CTlmRing ring;
+    CTlmDecoder d (frame, &s);
+    clear (s, 0, 0);
+    const int cols = 26, rows = 16;
+    clear (ref, cols, rows);
+    uint8_t body[2] = { cols, rows };
+    ring.frame (TLM_SCREEN, body, 2);
+
+    for (uint32_t f = 0; f < frames; ++f) {
+        // a frame of random runs, bytes 0 included to exercise COBS
+        uint8_t cells[TLM_MAXBODY];
+        uint16_t len = 0;
+        while (len + 5 <= TLM_MAXBODY) {
+            int y = rand () % rows, x = rand () % cols;
+            int n = 1 + rand () % (cols - x);
+            if (len + 3 + 2 * n > TLM_MAXBODY) break;
+            cells[len++] = y;
+            cells[len++] = x;
+            cells[len++] = n;
+            for (int k = 0; k < n; ++k) {
+                ref.cell[y][x+k][0] = cells[len++] = rand () % 4 ? rand () : 0;
+                ref.cell[y][x+k][1] = cells[len++] = rand () % 4 ? rand () : 0;
+            }
+        }
+        ring.frame (TLM_CELLS, cells, len);
+        if (f % 7 == 0) {
+            uint16_t lv[2] = { (uint16_t) rand (), 0 };
+            ring.frame (TLM_CHANNELS, (const uint8_t *) lv, 4);
+        }
+        pump (ring, master, slave, d);
+        if (f % 13 == 0) {
+            // line noise between frames; the decoder resyncs at the zero
+            uint8_t junk[17];
+            for (int i = 0; i < 16; ++i) junk[i] = 1 + rand () % 255;
+            junk[16] = 0;
+            write (master, junk, sizeof (junk));
+        }
+    }
+    pump (ring, master, slave, d);
+    usleep (10000);
+    uint8_t buf[4096];
+    ssize_t r;
+    while ((r = read (slave, buf, sizeof (buf))) > 0)
+        for (ssize_t i = 0; i < r; ++i) d.put (buf[i]);
+
+    int bad = 0;
+    for (int y = 0; y < rows; ++y)
+        bad += memcmp (s.cell[y], ref.cell[y], 2 * cols) != 0;
+    bool ok = (bad == 0) && (s.cols == cols) && (d.lost () == 0);
+    printf ("%u frames decoded, %u bad (noise), %u lost, %d rows differ\n",
+            s.frames, d.errors (), d.lost (), bad);
+    ok = mirror () && ok;
+    printf ("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+int
+main (int argc, char **argv)
+{
+    if (argc < 2) {
+        fprintf (stderr, "usage: %s device | - | --selftest [frames [seed]]\n",
+                 argv[0]);
+        return 2;
+    }
+    if (!strcmp (argv[1], "--selftest")) {
+        srand (argc > 3 ? atoi (argv[3]) : 1);
+        return selftest (argc > 2 ? atoi (argv[2]) : 2000);
+    }
+    return monitor (argv[1]);
+}
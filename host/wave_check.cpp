@@ -0,0 +1,68 @@
+/// @file wave_check.cpp
+/// @brief Check the wavetable interpolation of CWaveVoice on the host
+///
+/// Renders every wave shape at several levels and phase increments and
+/// checks that each sample lies between the two table entries it
+/// interpolates. The square and saw tables jump by nearly full scale
+/// between adjacent entries, so an overflowing interpolation shows up
+/// there as a sample outside the jump; below full level the DAC clamp
+/// cannot hide it. Build with -fsanitize=undefined to have any overflow
+/// reported as well.
+///
+/// Build: g++ -O2 -I../source -o wave_check wave_check.cpp
+///            ../source/wavegen.cpp
+/// Usage: wave_check
+
+#include <stdio.h>
+#include "wavegen.hpp"
+
+#define SAMPLES 4096            ///< samples rendered per shape and increment
+
+static const char *const s_names[WAVE_SHAPES] = { "sine", "square", "triangle", "saw" };
+
+/// @brief Get the DAC code of a Q15 sample at a Q15 level, as render() does
+static int32_t
+code (int32_t s, int32_t level)
+{
+    s = DAC_MID + (((s * level) >> 15) >> (16 - DAC_BITS));
+    return (s < 0) ? 0 : (s > DAC_MAX) ? DAC_MAX : s;
+}
+
+int
+main ()
+{
+    static const uint32_t millihz[] = { 1000, 440000, 1234567, 5000000 };
+    static const uint16_t levels[] = { 32768, 20000, 8192 };
+    static uint16_t buf[SAMPLES];
+    int failures = 0;
+    for (uint8_t shape = 0; shape < WAVE_SHAPES; ++shape) {
+        const int16_t *table = CWaveVoice::table (shape);
+        unsigned bad = 0;
+        for (unsigned f = 0; f < sizeof (millihz) / sizeof (millihz[0]); ++f)
+        for (unsigned l = 0; l < sizeof (levels) / sizeof (levels[0]); ++l) {
+            int32_t level = levels[l];
+            CWaveVoice v;
+            v.setShape (shape);
+            v.setLevel (level);
+            uint32_t inc = CWaveVoice::increment (millihz[f], 48000);
+            v.setIncrement (inc);
+            v.render (buf, SAMPLES, 1, 0);
+            uint32_t phase = 0;
+            for (unsigned n = 0; n < SAMPLES; ++n, phase += inc) {
+                uint32_t i = phase >> (32 - WAVE_BITS);
+                int32_t a = code (table[i], level);
+                int32_t b = code (table[(i + 1) & (WAVE_SIZE - 1)], level);
+                int32_t lo = (a < b) ? a : b, hi = (a < b) ? b : a;
+                if ((buf[n] >= lo) && (buf[n] <= hi)) continue;
+                if (!bad++)
+                    printf ("%s: %u mHz level %d sample %u is %u, not within %d..%d\n",
+                            s_names[shape], (unsigned) millihz[f], (int) level, n,
+                            buf[n], (int) lo, (int) hi);
+            }
+        }
+        printf ("%-8s  %6u samples outside their table entries\n", s_names[shape], bad);
+        if (bad) ++failures;
+    }
+    printf ("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
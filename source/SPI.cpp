@@ -15,7 +15,7 @@
 #define SPI_CLK_DIVIDER 2       // 42 MHz SPI clock
 
 SPIClass::SPIClass(Spi *_spi, uint32_t _id, uint8_t _pin, uint8_t _dma)
-: spi (_spi), id (_id), pin (_pin), dma (_dma), initialized (false)
+: spi (_spi), id (_id), pin (_pin), dma (_dma), initialized (false), sleeping (false)
 {
     // Empty
 }
@@ -31,6 +31,7 @@ SPIClass::begin () {
     DMAC->DMAC_EN &= (~DMAC_EN_ENABLE);
     DMAC->DMAC_GCFG = DMAC_GCFG_ARB_CFG_FIXED;
     DMAC->DMAC_EN = DMAC_EN_ENABLE;
+    NVIC_EnableIRQ (DMAC_IRQn);
 
     PIO_Configure(
             g_APinDescription[PIN_SPI_MOSI].pPort,
@@ -96,7 +97,15 @@ SPIClass::transferBuffer (uint8_t *data, uint16_t length)
 
 byte SPIClass::waitForDMA ()
 {
-    while (DMAC->DMAC_CHSR & (DMAC_CHSR_ENA0 << dma)) ;
+    while (DMAC->DMAC_CHSR & (DMAC_CHSR_ENA0 << dma)) {
+        if (!sleeping) continue;
+        // WFI wakes on the pending DMAC interrupt even with interrupts 
+        // masked, so a transfer ending before WFI cannot be missed
+        __disable_irq ();
+        if (DMAC->DMAC_CHSR & (DMAC_CHSR_ENA0 << dma))
+            __WFI ();
+        __enable_irq ();
+    }
     while ((spi->SPI_SR & SPI_SR_TXEMPTY) == 0) ;
     return spi->SPI_RDR;    
 }
@@ -127,8 +136,17 @@ void SPIClass::sendBufferDMA (const uint8_t *data, uint16_t length)
                                     | DMAC_CFG_DST_H2SEL 
                                     | DMAC_CFG_SOD 
                                     | DMAC_CFG_FIFOCFG_ALAP_CFG;
+    // interrupt on buffer transfer completion to wake a sleeping waitForDMA
+    DMAC->DMAC_EBCIER = DMAC_EBCIER_BTC0 << dma;
     // enable channel to start DMA transfer
     DMAC->DMAC_CHER = DMAC_CHER_ENA0 << dma;    
 }
 
+void DMAC_Handler ()
+{
+    // reading the status clears it; waking the CPU is all that is needed
+    uint32_t dummy = DMAC->DMAC_EBCISR;
+    (void) dummy;
+}
+
 SPIClass SPI(SPI_INTERFACE, SPI_INTERFACE_ID, BOARD_SPI_DEFAULT_SS, 0);
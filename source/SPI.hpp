@@ -32,6 +32,9 @@ public:
     byte waitForDMA ();
     void sendBufferDMA (const uint8_t *_data, uint16_t _length);
 
+    // Sleep the CPU until the DMAC interrupt instead of spinning in waitForDMA
+    void sleepOnWait (bool _sleep) { sleeping = _sleep; }
+
     void begin ();
     void end ();
 
@@ -41,6 +44,7 @@ protected:
     uint8_t pin;
     uint8_t dma;
     bool initialized;
+    bool sleeping;
 };
 
 extern SPIClass SPI;
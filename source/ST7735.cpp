@@ -4,13 +4,17 @@ Slimmed-down ST7735.cpp + GFX.cpp from ADAFRUIT
 - removed software spi support
 - spi clock upped to 14 Mhz 
 - reset delays reduced to 50 ms
-- fixed rotation to '3' (hold panel horizontally with connector to the left)
+- default rotation '3' (hold panel horizontally with connector to the left)
 - removed inversion
 - improved character drawchar speed
 - added drawing strings
 - added rgb 332 bitmaps
 - tear effect control enabled
 - added a full ASCII textbuffer class with double buffering
+- multiple text pages with diff-based page switching
+- optional capture of the SPI byte stream (ST7735_CAPTURE)
+- sleep, idle and partial display modes
+- runtime rotation done by the panel via MADCTL
 ******************************************************************************** 
 This is a library for the Adafruit 1.8" SPI display.
 This library works with the Adafruit 1.8" TFT Breakout w/SD card
@@ -33,6 +37,7 @@ MIT license, all text above must be included in any redistribution
 #include "pins_arduino.h"
 #include "wiring_private.h"
 #include "SPI.hpp"
+#include "cycles.hpp"
 #include "ST7735.hpp"
 
 // Bits for MADCTL command
@@ -71,6 +76,8 @@ enum st7735_command_bytes_t {
     ST7735_TEOFF   = 0x34,
     ST7735_TEON    = 0x35,
     ST7735_MADCTL  = 0x36,
+    ST7735_IDMOFF  = 0x38,
+    ST7735_IDMON   = 0x39,
     ST7735_COLMOD  = 0x3A,
 
     ST7735_FRMCTR1 = 0xB1,
@@ -98,11 +105,21 @@ enum st7735_command_bytes_t {
 };
 
 
-// A 6x8 pixel character font
+// A 6x8 pixel character font, transcoded to FONT_LAYOUT
+const uint8_t Adafruit_ST7735::font[256 * FONT_GLYPHBYTES] = {
 #include "font6x8H.i"
+};
 // A 16 color RGB565 palette
 #include "palette.i"
 
+// MADCTL per rotation; '3' is the boot default from Rcmd
+static const uint8_t madctl_rotation[4] = {
+    MADCTL_MX | MADCTL_MY | MADCTL_RGB,     // 0: portrait
+    MADCTL_MX | MADCTL_MV | MADCTL_RGB,     // 1: landscape, connector right
+    MADCTL_RGB,                             // 2: portrait, upside down
+    MADCTL_MY | MADCTL_MV | MADCTL_RGB      // 3: landscape, connector left
+};
+
 // special number of commands to indicate a delay
 #define DELAY 0x80
 
@@ -174,6 +191,7 @@ Adafruit_ST7735::writecommand (uint8_t c)
     m_csport->PIO_CODR |= m_cspinmask;
     SPI.transfer (c);
     m_csport->PIO_SODR |= m_cspinmask;
+    capture (CAPTURE_COMMAND, &c, 1);
 }
 
 void 
@@ -183,6 +201,7 @@ Adafruit_ST7735::writedata (uint8_t c)
     m_csport->PIO_CODR |= m_cspinmask;
     SPI.transfer (c);
     m_csport->PIO_SODR |= m_cspinmask;
+    capture (CAPTURE_DATA, &c, 1);
 } 
 
 void 
@@ -210,7 +229,10 @@ Adafruit_ST7735::Adafruit_ST7735 ()
   m_rspinmask (0),
   m_cs (0),
   m_rs (0),
-  m_rst (0)
+  m_rst (0),
+  m_width (ST7735_TFTWIDTH),
+  m_height (ST7735_TFTHEIGHT),
+  m_rotation (3)
 {
 }
 
@@ -263,9 +285,50 @@ Adafruit_ST7735::configure (uint32_t cs, uint32_t rs, uint32_t rst)
         }
     }
 
+    setRotation (m_rotation);
     fillScreen (BLACK);
 }
 
+void
+Adafruit_ST7735::setRotation (uint8_t r)
+{
+    m_rotation = r & 3;
+    writecommand (ST7735_MADCTL);
+    writedata (madctl_rotation[m_rotation]);
+    // MV swaps rows and columns, so odd rotations are landscape
+    m_width = (m_rotation & 1) ? ST7735_TFTWIDTH : ST7735_TFTHEIGHT;
+    m_height = (m_rotation & 1) ? ST7735_TFTHEIGHT : ST7735_TFTWIDTH;
+}
+
+void
+Adafruit_ST7735::displaySleep (bool on)
+{
+    writecommand (on ? ST7735_SLPIN : ST7735_SLPOUT);
+}
+
+void
+Adafruit_ST7735::displayIdle (bool on)
+{
+    writecommand (on ? ST7735_IDMON : ST7735_IDMOFF);
+}
+
+void
+Adafruit_ST7735::displayPartial (coord_t r0, coord_t r1)
+{
+    writecommand (ST7735_PTLAR);
+    writedata (0x00);
+    writedata (r0);
+    writedata (0x00);
+    writedata (r1);
+    writecommand (ST7735_PTLON);
+}
+
+void
+Adafruit_ST7735::displayNormal ()
+{
+    writecommand (ST7735_NORON);
+}
+
 void
 Adafruit_ST7735::drawPixel (coord_t x, coord_t y, color_t color) 
 {
@@ -274,8 +337,8 @@ Adafruit_ST7735::drawPixel (coord_t x, coord_t y, color_t color)
     uint8_t hi = color >> 8, lo = color;
     m_rsport->PIO_SODR |= m_rspinmask;
     m_csport->PIO_CODR |= m_cspinmask;
-    SPI.transfer (hi);
-    SPI.transfer (lo);
+    spiwrite (hi);
+    spiwrite (lo);
     m_csport->PIO_SODR |= m_cspinmask;
 }
 
@@ -288,8 +351,8 @@ Adafruit_ST7735::drawVLine (coord_t x, coord_t y, coord_t h, color_t color)
     m_rsport->PIO_SODR |= m_rspinmask;
     m_csport->PIO_CODR |= m_cspinmask;
     while (h--) {
-        SPI.transfer (hi);
-        SPI.transfer (lo);
+        spiwrite (hi);
+        spiwrite (lo);
     }
     m_csport->PIO_SODR |= m_cspinmask;
 }
@@ -303,8 +366,8 @@ Adafruit_ST7735::drawHLine (coord_t x, coord_t y, coord_t w, color_t color)
     m_rsport->PIO_SODR |= m_rspinmask;
     m_csport->PIO_CODR |= m_cspinmask;
     while (w--) {
-        SPI.transfer (hi);
-        SPI.transfer (lo);
+        spiwrite (hi);
+        spiwrite (lo);
     }
     m_csport->PIO_SODR |= m_cspinmask;
 }
@@ -312,7 +375,7 @@ Adafruit_ST7735::drawHLine (coord_t x, coord_t y, coord_t w, color_t color)
 void 
 Adafruit_ST7735::fillScreen (color_t color) 
 {
-    fillRect (0, 0, ST7735_TFTWIDTH, ST7735_TFTHEIGHT, color);
+    fillRect (0, 0, m_width, m_height, color);
 }
 
 void 
@@ -326,8 +389,8 @@ Adafruit_ST7735::fillRect (coord_t x, coord_t y, coord_t w, coord_t h, color_t c
     m_rsport->PIO_SODR |= m_rspinmask;
     m_csport->PIO_CODR |= m_cspinmask;
     for (count = h*w; count > 0; --count) {
-        SPI.transfer (hi);
-        SPI.transfer (lo);
+        spiwrite (hi);
+        spiwrite (lo);
     }
     m_csport->PIO_SODR |= m_cspinmask;
 }
@@ -347,17 +410,19 @@ Adafruit_ST7735::drawChar (coord_t x, coord_t y, unsigned char c, color_t fg, co
     uint8_t i, j;
     uint16_t color;
     uint8_t line;
+    uint8_t glyph[FONTHEIGHT];
+    const uint8_t *rows = font_glyph (font, c, glyph);
 
     setAddrWindow (x, y, x+FONTWIDTH, y+FONTHEIGHT);
     m_rsport->PIO_SODR |= m_rspinmask;
     m_csport->PIO_CODR |= m_cspinmask;
-    for (j = c*FONTHEIGHT; j < (c+1)*FONTHEIGHT; ++j) {
-        line = font[j];
+    for (j = 0; j < FONTHEIGHT; ++j) {
+        line = rows[j];
         for (i = 0; i < FONTWIDTH; ++i) {
             color = (line & 1) ? fg : bg; 
             line >>= 1;
-            SPI.transfer (color >> 8);
-            SPI.transfer (color);
+            spiwrite (color >> 8);
+            spiwrite (color);
         }
     }
     m_csport->PIO_SODR |= m_cspinmask;      
@@ -370,6 +435,11 @@ Adafruit_ST7735::drawString (coord_t x, coord_t y, char *c, color_t fg, color_t
         drawChar (x, y, *c, fg, bg);
 }
 
+#ifdef ST7735_CAPTURE
+Adafruit_ST7735::capture_fn_t Adafruit_ST7735::s_capture = 0;
+uint32_t Adafruit_ST7735::s_capturebytes = 0;
+#endif
+
 // =============================================================================
 // TextFrameBuffer
 // =============================================================================
@@ -378,13 +448,71 @@ TextFrameBuffer *TextFrameBuffer::s_singleton = 0;
 
 TextFrameBuffer::TextFrameBuffer ()
 : Adafruit_ST7735 ()
+#ifdef ST7735_CAPTURE
+, m_framestart (0), m_framebytes (0)
+#endif
 {
     if (!s_singleton)
         s_singleton = this;
     textAttr (ATTR (7, 0));
-    memset (m_buf, 0x00, ST7735_SCRWIDTH*ST7735_SCRHEIGHT*2);
+    memset (m_pages, 0x00, sizeof (m_pages));
+    for (uint8_t i = 0; i < TFB_GLYPHS; ++i) {
+        // decoding layouts fill the buffer and return it, FONT_ROWS points
+        // into the font
+        const uint8_t *rows = font_glyph (font, TFB_GLYPH0 + i, m_glyphs[i]);
+        if (rows != m_glyphs[i]) memcpy (m_glyphs[i], rows, FONTHEIGHT);
+    }
+    m_cols = ST7735_SCRWIDTH;
+    m_rows = ST7735_SCRHEIGHT;
+    m_drawpage = 0;
+    m_showpage = 0;
+    m_buf = m_pages[0];
+    m_mirror = 0;
+    m_framerows = false;
+    m_frames = 0;
+    m_framestamp = 0;
+    m_framebegin = 0;
+    m_passstart = 0;
+    m_slicerow = 0;
+    dirty_clean ();
+    dirty_update (0, 0, m_cols, m_rows);
+}
+
+void 
+TextFrameBuffer::setRotation (uint8_t r)
+{
+    Adafruit_ST7735::setRotation (r);
+    m_cols = m_width / FONTWIDTH;
+    m_rows = m_height / FONTHEIGHT;
+    m_slicerow = 0;
+    // the layout changed, so everything on the glass is stale
     dirty_clean ();
-    dirty_update (0, 0, ST7735_SCRWIDTH, ST7735_SCRHEIGHT);
+    for (coord_t y = 0; y < m_rows; ++y)
+        m_dirty[y] = span_mask (0, m_cols);
+}
+
+void 
+TextFrameBuffer::selectPage (uint8_t page)
+{
+    if (page >= TFB_PAGES) return;
+    m_drawpage = page;
+    m_buf = m_pages[page];
+}
+
+void 
+TextFrameBuffer::showPage (uint8_t page)
+{
+    if ((page >= TFB_PAGES) || (page == m_showpage)) return;
+    // the glass shows the old page except for its pending dirty cells, 
+    // so adding the cells where both pages differ is exact
+    const page_t &oldp = m_pages[m_showpage];
+    const page_t &newp = m_pages[page];
+    for (coord_t y = 0; y < m_rows; ++y)
+        for (coord_t x = 0; x < m_cols; ++x)
+            if ((oldp[y][x][0] != newp[y][x][0]) || 
+                (oldp[y][x][1] != newp[y][x][1]))
+                m_dirty[y] |= 1UL << x;
+    m_showpage = page;
 }
 
 void 
@@ -404,7 +532,7 @@ TextFrameBuffer::putChAt (coord_t x, coord_t y, char ch, uint8_t at)
 void 
 TextFrameBuffer::textOut (coord_t x, coord_t y, const char *s, uint16_t length)
 {
-    if ((x >= ST7735_SCRWIDTH) || (y < 0) || (y >= ST7735_SCRHEIGHT)) return;
+    if ((x >= m_cols) || (y < 0) || (y >= m_rows)) return;
     while ((x < 0) && (*s != 0) && (length > 0)) {
         ++x;
         ++s;
@@ -413,7 +541,7 @@ TextFrameBuffer::textOut (coord_t x, coord_t y, const char *s, uint16_t length)
     if (length == 0 || *s == 0) return;
 
     coord_t x0 = x;
-    while ((x < ST7735_SCRWIDTH) && (*s != 0) && (length > 0)) {
+    while ((x < m_cols) && (*s != 0) && (length > 0)) {
         m_buf[y][x][0] = *s;
         m_buf[y][x][1] = m_at;
         ++x;
@@ -443,6 +571,79 @@ TextFrameBuffer::decimalOut (coord_t x, coord_t y, uint32_t val,
     }
 }
 
+void 
+TextFrameBuffer::fieldOut (coord_t x, coord_t y, const field_t &f, int32_t val)
+{
+    static const char digits[] = "0123456789ABCDEF";
+    coord_t x1 = x + f.width;
+    if ((x < 0) || (x1 > m_cols) || (y < 0) || (y >= m_rows)) return;
+    uint8_t (*row)[2] = m_buf[y];
+    uint8_t at = f.at ? f.at : m_at;
+
+    // unit suffix, left-aligned at the right end of the field
+    coord_t nx1 = x1;
+    if (f.suffix) {
+        nx1 -= strlen (f.suffix);
+        if (nx1 < x) nx1 = x;
+        for (coord_t cx = nx1; cx < x1; ++cx) {
+            row[cx][0] = f.suffix[cx - nx1];
+            row[cx][1] = at;
+        }
+    }
+
+    // digits from right to left
+    bool neg = (f.kind != field_t::HEX) && (val < 0);
+    uint32_t u = neg ? -(uint32_t) val : (uint32_t) val;
+    if (f.kind == field_t::PERCENT) {
+        uint32_t scale = 100;
+        for (uint8_t i = 0; i < f.ndecimal; ++i) scale *= 10;
+        u = ((uint64_t) u * scale + 0x8000) >> 16;
+    }
+    uint32_t base = (f.kind == field_t::HEX) ? 16 : 10;
+    coord_t cx = nx1 - 1;
+    uint8_t place = 0;
+    do {
+        if (cx < x) goto overflow;
+        row[cx][0] = digits[u % base];
+        row[cx--][1] = at;
+        u /= base;
+        if (++place == f.ndecimal) {
+            if (cx < x) goto overflow;
+            row[cx][0] = '.';
+            row[cx--][1] = at;
+        }
+    } while ((u > 0) || (place <= f.ndecimal));
+
+    {
+        // sign and padding
+        char sign = neg ? '-' : ((f.flags & field_t::PLUS) ? '+' : 0);
+        if (sign && (cx < x)) goto overflow;
+        if (f.flags & field_t::ZERO) {
+            for ( ; cx >= x + (sign ? 1 : 0); --cx) {
+                row[cx][0] = '0';
+                row[cx][1] = at;
+            }
+        }
+        if (sign) {
+            row[cx][0] = sign;
+            row[cx--][1] = at;
+        }
+        for ( ; cx >= x; --cx) {
+            row[cx][0] = ' ';
+            row[cx][1] = at;
+        }
+    }
+    dirty_update (x, y, x1, y+1);
+    return;
+
+overflow:
+    for (cx = x; cx < nx1; ++cx) {
+        row[cx][0] = '#';
+        row[cx][1] = at;
+    }
+    dirty_update (x, y, x1, y+1);
+}
+
 void 
 TextFrameBuffer::bar (coord_t x0, coord_t y0, coord_t x1, coord_t y1, char ch, uint8_t at)
 {
@@ -502,76 +703,159 @@ TextFrameBuffer::hbar (coord_t x0, coord_t y0, uint8_t halfchars, uint8_t maxhal
 }
 
 
+void
+TextFrameBuffer::setGlyph (uint8_t c, const uint8_t *rows)
+{
+    uint8_t g = c - TFB_GLYPH0;
+    if ((g >= TFB_GLYPHS) || !memcmp (m_glyphs[g], rows, FONTHEIGHT)) return;
+    memcpy (m_glyphs[g], rows, FONTHEIGHT);
+    // the glyph is on the glass wherever the shown page holds it
+    const page_t &buf = m_pages[m_showpage];
+    for (coord_t y = 0; y < m_rows; ++y)
+        for (coord_t x = 0; x < m_cols; ++x)
+            if (buf[y][x][0] == c) m_dirty[y] |= 1UL << x;
+}
+
 void
 TextFrameBuffer::dirty_clean ()
 {
-    m_dirty.x0 = ST7735_SCRWIDTH;
-    m_dirty.y0 = ST7735_SCRHEIGHT;
-    m_dirty.x1 = 0;
-    m_dirty.y1 = 0; 
+    for (coord_t y = 0; y < TFB_ROWS; ++y)
+        m_dirty[y] = 0;
 }
 
 void
 TextFrameBuffer::dirty_update (coord_t x0, coord_t y0, coord_t x1, coord_t y1)
 {
-    x0 = constrain (x0, 0, ST7735_SCRWIDTH);
-    x1 = constrain (x1, 0, ST7735_SCRWIDTH);
-    y0 = constrain (y0, 0, ST7735_SCRHEIGHT);
-    y1 = constrain (y1, 0, ST7735_SCRHEIGHT);
-    m_dirty.x0 = min (m_dirty.x0, x0);
-    m_dirty.y0 = min (m_dirty.y0, y0);
-    m_dirty.x1 = max (m_dirty.x1, x1);
-    m_dirty.y1 = max (m_dirty.y1, y1);
+    // drawing to a hidden page does not touch the glass
+    if (m_drawpage != m_showpage) return;
+    x0 = constrain (x0, 0, m_cols);
+    x1 = constrain (x1, 0, m_cols);
+    y0 = constrain (y0, 0, m_rows);
+    y1 = constrain (y1, 0, m_rows);
+    uint32_t mask = span_mask (x0, x1);
+    for (coord_t y = y0; y < y1; ++y)
+        m_dirty[y] |= mask;
 }
 
 void 
 TextFrameBuffer::render ()
 {
-    if ((m_dirty.x1 > m_dirty.x0) && (m_dirty.y1 > m_dirty.y0)) {
-        // dma transfer buffers
-        uint16_t scanline[2][ST7735_TFTWIDTH];
-        uint32_t dummy;
-        uint8_t nbuf = 0;
-        // address dirty region
-        setAddrWindow (m_dirty.x0 * FONTWIDTH, m_dirty.y0 * FONTHEIGHT, 
-                       m_dirty.x1 * FONTWIDTH - 1, m_dirty.y1 * FONTHEIGHT - 1);
-        m_rsport->PIO_SODR |= m_rspinmask;
-        m_csport->PIO_CODR |= m_cspinmask;
-        // character row
-        for (coord_t y = m_dirty.y0; y < m_dirty.y1; ++y) {
-            // character scanlines
-            for (coord_t jj = 0; jj < FONTHEIGHT; ++jj) {
+    while (renderSlice (m_rows)) ;
+}
+
+bool 
+TextFrameBuffer::renderSlice (coord_t maxrows)
+{
+    // a pass over all rows may take several slices; continuing where the
+    // last slice stopped keeps rows that are dirtied again and again from
+    // starving the rows below them
+    if (m_slicerow == 0) m_passstart = cycles ();
+    // each run of dirty cells is sent as a window of its own, so cells
+    // between runs cost nothing; consecutive rows dirty in just the same
+    // run are coalesced into rectangles
+    coord_t y = m_slicerow, done = 0;
+    while ((y < m_rows) && (done < maxrows)) {
+        uint32_t mask = m_dirty[y];
+        if (!mask) {
+            ++y;
+            continue;
+        }
+        coord_t x0 = __builtin_ctz (mask);
+        coord_t x1 = x0 + __builtin_ctz (~(mask >> x0));
+        uint32_t run = span_mask (x0, x1);
+        rect_t r = { x0, y, x1, (coord_t) (y+1) };
+        if (mask == run)
+            while ((r.y1 < m_rows) && (r.y1 - r.y0 < maxrows - done) 
+                   && (m_dirty[r.y1] == run))
+                ++r.y1;
+        render_rect (r);
+        if (m_mirror) m_mirror (r.y0, r.y1);
+        m_framerows = true;
+        for (coord_t ry = r.y0; ry < r.y1; ++ry)
+            m_dirty[ry] &= ~run;
+        if (m_dirty[y]) continue;
+        done += r.y1 - r.y0;
+        y = r.y1;
+    }
+    for (coord_t ry = y; ry < m_rows; ++ry)
+        if (m_dirty[ry]) {
+            m_slicerow = y;
+            return true;
+        }
+
+    // end of the pass: every row dirty at its start has been rendered
+    m_slicerow = 0;
+    if (m_framerows) {
+        // render_rect() waited for the DMA, so the panel holds the frame
+        m_framestamp = cycles ();
+        m_framebegin = m_passstart;
+        ++m_frames;
+        m_framerows = false;
+    }
+#ifdef ST7735_CAPTURE
+    m_framebytes = s_capturebytes - m_framestart;
+    m_framestart = s_capturebytes;
+    capture (CAPTURE_FRAME, 0, 0);
+#endif
+    for (y = 0; y < m_rows; ++y)
+        if (m_dirty[y]) return true;
+    return false;
+}
+
+void 
+TextFrameBuffer::render_rect (const rect_t &r)
+{
+    const page_t &buf = m_pages[m_showpage];
+    // dma transfer buffers
+    uint16_t scanline[2][TFB_COLS*FONTWIDTH];
+    uint8_t nbuf = 0;
+    // glyph rows of the character row, decoded once for all its scanlines
+    uint8_t glyphs[TFB_COLS][FONTHEIGHT];
+    const uint8_t *rows[TFB_COLS];
+    // address dirty region
+    setAddrWindow (r.x0 * FONTWIDTH, r.y0 * FONTHEIGHT, 
+                   r.x1 * FONTWIDTH - 1, r.y1 * FONTHEIGHT - 1);
+    m_rsport->PIO_SODR |= m_rspinmask;
+    m_csport->PIO_CODR |= m_cspinmask;
+    // character row
+    for (coord_t y = r.y0; y < r.y1; ++y) {
+        for (coord_t x = r.x0; x < r.x1; ++x) {
+            uint8_t g = buf[y][x][0] - TFB_GLYPH0;
+            rows[x] = (g < TFB_GLYPHS) ? m_glyphs[g] 
+                    : font_glyph (font, buf[y][x][0], glyphs[x]);
+        }
+        // character scanlines
+        for (coord_t jj = 0; jj < FONTHEIGHT; ++jj) {
+            // character pixels
+            nbuf = 1-nbuf;
+            uint16_t *dst = scanline[nbuf];
+            for (coord_t x = r.x0; x < r.x1; ++x) {
+                uint8_t line = rows[x][jj];
+                color_t fg = s_palette[buf[y][x][1] & 0x0f][0];
+                color_t bg = s_palette[buf[y][x][1] >> 4][1];
                 // character pixels
-                nbuf = 1-nbuf;
-                uint16_t *dst = scanline[nbuf];
-                for (coord_t x = m_dirty.x0; x < m_dirty.x1; ++x) {
-                    uint8_t line = font[m_buf[y][x][0]*FONTHEIGHT + jj];
-                    color_t fg = s_palette[m_buf[y][x][1] & 0x0f][0];
-                    color_t bg = s_palette[m_buf[y][x][1] >> 4][1];
-                    // character pixels
-                    *dst++ = (line & 1) ? fg : bg; 
-                    *dst++ = (line & 2) ? fg : bg; 
-                    *dst++ = (line & 4) ? fg : bg; 
-                    *dst++ = (line & 8) ? fg : bg; 
-                    *dst++ = (line & 16) ? fg : bg; 
-                    #if (FONTWIDTH >= 6)
-                    *dst++ = (line & 32) ? fg : bg; 
-                    #endif
-                    #if (FONTWIDTH >= 7)
-                    *dst++ = (line & 64) ? fg : bg; 
-                    #endif
-                    #if (FONTWIDTH >= 8)
-                    *dst++ = (line & 128) ? fg : bg; 
-                    #endif
-                }       
-                // send buffer via SPI to ST7735.
-                // parallelize scanline assembly (CPU) and transfer (DMA)
-                SPI.waitForDMA ();
-                SPI.sendBufferDMA ((const uint8_t *) scanline[nbuf], (m_dirty.x1 - m_dirty.x0) * FONTWIDTH * 2);
-            }
+                *dst++ = (line & 1) ? fg : bg; 
+                *dst++ = (line & 2) ? fg : bg; 
+                *dst++ = (line & 4) ? fg : bg; 
+                *dst++ = (line & 8) ? fg : bg; 
+                *dst++ = (line & 16) ? fg : bg; 
+                #if (FONTWIDTH >= 6)
+                *dst++ = (line & 32) ? fg : bg; 
+                #endif
+                #if (FONTWIDTH >= 7)
+                *dst++ = (line & 64) ? fg : bg; 
+                #endif
+                #if (FONTWIDTH >= 8)
+                *dst++ = (line & 128) ? fg : bg; 
+                #endif
+            }       
+            // send buffer via SPI to ST7735.
+            // parallelize scanline assembly (CPU) and transfer (DMA)
+            SPI.waitForDMA ();
+            SPI.sendBufferDMA ((const uint8_t *) scanline[nbuf], (r.x1 - r.x0) * FONTWIDTH * 2);
+            capture (CAPTURE_DATA, (const uint8_t *) scanline[nbuf], (r.x1 - r.x0) * FONTWIDTH * 2);
         }
-        SPI.waitForDMA ();
-        m_csport->PIO_SODR |= m_cspinmask;      
-    }    
-    dirty_clean ();
+    }
+    SPI.waitForDMA ();
+    m_csport->PIO_SODR |= m_cspinmask;      
 }
@@ -23,7 +23,8 @@ MIT license, all text above must be included in any redistribution
 #define _ST7735_HPP_
 
 #include "Arduino.h"
-#include "Print.h"
+#include "SPI.hpp"
+#include "font.hpp"
 #include <include/pio.h>
 
 /// @brief Compose an attribute byte from 4-bit foreground and background palette indices
@@ -45,6 +46,70 @@ struct rect_t {
     coord_t x0, y0, x1, y1;
 };
 
+/// @brief A horizontal span containing x0 but not x1
+struct span_t {
+    coord_t x0, x1;
+};
+
+/// @brief A numeric field format for TextFrameBuffer::fieldOut. Formats are
+///        composed at compile time, so nothing is parsed at runtime, e.g.
+///        constexpr field_t F_MA = field_t (6).fixed (1).unit ("mA");
+struct field_t {
+    enum kind_t { DEC, HEX, PERCENT };
+    enum flag_t { PLUS = 1, ZERO = 2 };
+
+    uint8_t kind;           ///< one of kind_t
+    uint8_t width;          ///< total width in characters including unit
+    uint8_t ndecimal;       ///< number of post-decimal digits
+    uint8_t flags;          ///< composed from flag_t
+    uint8_t at;             ///< attribute, or 0 for the current text attribute
+    const char *suffix;     ///< unit appended right of the number, or 0
+
+    /// @brief A right-aligned, blank-padded signed decimal field
+    constexpr field_t (uint8_t w)
+    : kind (DEC), width (w), ndecimal (0), flags (0), at (0), suffix (0) {}
+    constexpr field_t (uint8_t k, uint8_t w, uint8_t n, uint8_t f, uint8_t a, const char *u)
+    : kind (k), width (w), ndecimal (n), flags (f), at (a), suffix (u) {}
+
+    /// @brief Fixed point: the value shown is val / 10^n
+    constexpr field_t fixed (uint8_t n) const { return field_t (kind, width, n, flags, at, suffix); }
+    /// @brief Unsigned hexadecimal
+    constexpr field_t hex () const { return field_t (HEX, width, 0, flags, at, suffix); }
+    /// @brief Percentage of a Q16 fraction, i.e. val = 65536 shows 100%
+    constexpr field_t percent () const { return field_t (PERCENT, width, ndecimal, flags, at, "%"); }
+    /// @brief Pad with leading zeros instead of blanks
+    constexpr field_t zero () const { return field_t (kind, width, ndecimal, flags | ZERO, at, suffix); }
+    /// @brief Show a '+' for positive values
+    constexpr field_t plus () const { return field_t (kind, width, ndecimal, flags | PLUS, at, suffix); }
+    /// @brief Draw the field with its own attribute, @see ATTR macro
+    constexpr field_t attr (uint8_t a) const { return field_t (kind, width, ndecimal, flags, a, suffix); }
+    /// @brief Append a unit string
+    constexpr field_t unit (const char *u) const { return field_t (kind, width, ndecimal, flags, at, u); }
+};
+
+/// @brief Text grid size in portrait rotation, for the 6x8 font
+#ifndef ST7735_SCRWIDTH_P
+#define ST7735_SCRWIDTH_P   (ST7735_TFTHEIGHT / 6)
+#define ST7735_SCRHEIGHT_P  (ST7735_TFTWIDTH / 8)
+#endif
+
+/// @brief Text grid size large enough for all rotations
+#define TFB_COLS ((ST7735_SCRWIDTH > ST7735_SCRWIDTH_P) ? ST7735_SCRWIDTH : ST7735_SCRWIDTH_P)
+#define TFB_ROWS ((ST7735_SCRHEIGHT > ST7735_SCRHEIGHT_P) ? ST7735_SCRHEIGHT : ST7735_SCRHEIGHT_P)
+
+#if (TFB_COLS > 32)
+#error "dirty cells of a row are tracked in 32 bits"
+#endif
+
+#ifndef TFB_GLYPHS
+#define TFB_GLYPHS 15   ///< Number of glyphs held in RAM, @see setGlyph()
+#endif
+#define TFB_GLYPH0 1    ///< Codepoint of the first RAM glyph
+
+#ifndef TFB_PAGES
+#define TFB_PAGES 6     ///< Number of text pages held in RAM
+#endif
+
 /// @brief Predefined RGB565 color constants
 enum st7735_colorconstants_t {
     BLACK     = 0x0000,
@@ -108,6 +173,20 @@ public:
     /// @brief Configure the pins of the TFT display
     void configure (uint32_t cs, uint32_t rs, uint32_t rst);
 
+    /// @brief Set the display rotation; the panel maps coordinates, so all
+    ///        rotations render at the same speed
+    /// @param r  0 and 2 are portrait, 1 and 3 landscape; 3 is the default
+    void setRotation (uint8_t r);
+
+    /// @brief Get the display rotation
+    uint8_t rotation () const { return m_rotation; }
+
+    /// @brief Get the pixel width in the current rotation
+    coord_t width () const { return m_width; }
+
+    /// @brief Get the pixel height in the current rotation
+    coord_t height () const { return m_height; }
+
     /// @brief Fill the entire screen in a solid RGB565 color
     void fillScreen (color_t color);
 
@@ -132,6 +211,40 @@ public:
     /// @brief Draw a string using the 6x8 bitmap font given foreground and background colors
     void drawString (coord_t x, coord_t y,  char *c, color_t color, color_t bg);
 
+    /// @brief Enter or leave panel sleep. Leaving sleep takes 120 ms before
+    ///        the panel accepts further commands.
+    void displaySleep (bool on);
+
+    /// @brief Enter or leave idle mode, showing 8 colors from the MSB of
+    ///        each color component
+    void displayIdle (bool on);
+
+    /// @brief Enter partial mode, driving only panel gate rows r0..r1 
+    ///        (inclusive); these are screen columns in landscape rotation
+    void displayPartial (coord_t r0, coord_t r1);
+
+    /// @brief Leave partial mode and drive the full panel
+    void displayNormal ();
+
+    /// @brief Kinds of records passed to a capture sink
+    enum capture_kind_t {
+        CAPTURE_COMMAND = 0,    ///< command byte, sent with RS low
+        CAPTURE_DATA    = 1,    ///< data bytes, sent with RS high
+        CAPTURE_FRAME   = 2     ///< end of a TextFrameBuffer::render(), no bytes
+    };
+
+    /// @brief A sink receiving every byte sent to the panel, @see setCapture
+    typedef void (*capture_fn_t) (uint8_t kind, const uint8_t *data, uint16_t length);
+
+#ifdef ST7735_CAPTURE
+    /// @brief Install a sink for the command/data byte stream sent to the 
+    ///        panel, or 0 to stop capturing. Only built with ST7735_CAPTURE.
+    static void setCapture (capture_fn_t fn) { s_capture = fn; }
+
+    /// @brief Get the total number of bytes sent to the panel
+    static uint32_t capturedBytes () { return s_capturebytes; }
+#endif
+
 protected:
     Adafruit_ST7735 ();
 
@@ -139,8 +252,26 @@ protected:
     void writecommand (uint8_t c);
     void writedata (uint8_t d);
 
+    /// @brief Send a data byte inside an open RS high / CS low transfer
+    void spiwrite (uint8_t d) { SPI.transfer (d); capture (CAPTURE_DATA, &d, 1); }
+
+    /// @brief Pass bytes sent to the panel to the capture sink, if any
+    void capture (uint8_t kind, const uint8_t *data, uint16_t length)
+    {
+#ifdef ST7735_CAPTURE
+        s_capturebytes += length;
+        if (s_capture) s_capture (kind, data, length);
+#else
+        (void) kind; (void) data; (void) length;
+#endif
+    }
+
     static const uint8_t Rcmd[];    ///< boot sequence commands
-    static const uint8_t font[];    ///< font for drawChar()
+    static const uint8_t font[];    ///< font in FONT_LAYOUT, @see font.hpp
+#ifdef ST7735_CAPTURE
+    static capture_fn_t s_capture;  ///< capture sink, or 0
+    static uint32_t s_capturebytes; ///< bytes sent since boot
+#endif
 
     Pio *m_csport;
     Pio *m_rsport;
@@ -149,6 +280,9 @@ protected:
     uint8_t m_cs;
     uint8_t m_rs;
     uint8_t m_rst;
+    coord_t m_width;        ///< pixel width in the current rotation
+    coord_t m_height;       ///< pixel height in the current rotation
+    uint8_t m_rotation;     ///< current rotation 0..3
 };
 
 /// @brief A text framebuffer class built on Adafruit_ST7735
@@ -161,10 +295,40 @@ public:
     /// @brief Get the singleton pointer to the text frame buffer
     static TextFrameBuffer *get () { return s_singleton; }
 
+    /// @brief Set the display rotation and resize the text grid to it. Page
+    ///        contents are kept; the whole screen is redrawn on next render.
+    /// @param r  0 and 2 are portrait, 1 and 3 landscape; 3 is the default
+    void setRotation (uint8_t r);
+
+    /// @brief Get the number of text columns in the current rotation
+    coord_t cols () const { return m_cols; }
+
+    /// @brief Get the number of text rows in the current rotation
+    coord_t rows () const { return m_rows; }
+
+    /// @brief Select the page that subsequent drawing calls write to.
+    ///        Drawing to a page that is not shown costs no SPI traffic.
+    /// @param page  Page index, 0 <= page < TFB_PAGES
+    void selectPage (uint8_t page);
+
+    /// @brief Make a page the one shown on the display. Only the cells that
+    ///        differ from what is currently on the glass are re-rendered.
+    /// @param page  Page index, 0 <= page < TFB_PAGES
+    void showPage (uint8_t page);
+
+    /// @brief Get the page that drawing calls write to
+    uint8_t drawPage () const { return m_drawpage; }
+
+    /// @brief Get the page shown on the display
+    uint8_t shownPage () const { return m_showpage; }
+
     /// @brief Set the foreground and background palette index as attribute
     /// @brief attr  8-bit character attribute, @see ATTR macro
     void textAttr (uint8_t attr);
 
+    /// @brief Get the current text attribute
+    uint8_t textAttr () const { return m_at; }
+
     /// @brief Put a character and attribute at a position
     /// @param x   Horizontal character coordinate
     /// @param y   Vertical character coordinate
@@ -189,6 +353,15 @@ public:
     void decimalOut (coord_t x, coord_t y, uint32_t val, uint16_t ndigits, 
                      uint16_t ndecimal, bool leadzero);
 
+    /// @brief Draw a formatted number right-aligned into a field of 
+    ///        f.width characters without intermediate buffers. A value that 
+    ///        does not fit is shown as '#' characters.
+    /// @param x    Left horizontal character coordinate
+    /// @param y    Vertical character coordinate
+    /// @param f    Field format, @see field_t
+    /// @param val  Value to draw
+    void fieldOut (coord_t x, coord_t y, const field_t &f, int32_t val);
+
     /// @brief Fill the currently set window with a character and color
     /// @param x0  Horizontal character coordinate
     /// @param y0  Vertical character coordinate
@@ -212,20 +385,85 @@ public:
     /// @param maxhalfchars  Maximum bar length in half characters
     void hbar (coord_t x0, coord_t y0, uint8_t halfchars, uint8_t maxhalfchars);
 
+    /// @brief Replace the glyph of a codepoint TFB_GLYPH0 ... TFB_GLYPH0 +
+    ///        TFB_GLYPHS - 1 with rows held in RAM; these codepoints' font
+    ///        glyphs are unused control characters. Glyphs are shared by
+    ///        all pages. If the rows differ, the cells of the shown page 
+    ///        holding the codepoint are redrawn.
+    /// @param c     Codepoint
+    /// @param rows  FONTHEIGHT rows, leftmost pixel in bit 0
+    void setGlyph (uint8_t c, const uint8_t *rows);
+
     /// @brief Render the text buffer to the ST7735 TFT display via DMAC
     void render ();
 
+    /// @brief Render at most maxrows dirty character rows, to bound the
+    ///        time spent per call, e.g. as a CScheduler task. Slices 
+    ///        continue down the screen where the previous one stopped.
+    /// @param maxrows  Largest number of character rows to render
+    /// @return         true if dirty rows remain
+    bool renderSlice (coord_t maxrows);
+
+    /// @brief A hook told which rows of the shown page were rendered
+    typedef void (*mirror_fn_t) (coord_t y0, coord_t y1);
+
+    /// @brief Install a hook called after rows y0..y1-1 were rendered, 
+    ///        e.g. to mirror the screen elsewhere; 0 to remove it
+    void setMirror (mirror_fn_t fn) { m_mirror = fn; }
+
+    /// @brief Get the number of frames that sent rows to the panel
+    uint32_t frames () const { return m_frames; }
+
+    /// @brief Get the cycle counter time at which the DMA of the last 
+    ///        frame that sent rows finished, @see cycles()
+    uint32_t frameStamp () const { return m_framestamp; }
+
+    /// @brief Get the cycle counter time at which the last frame that sent
+    ///        rows began; rows dirtied before then are on the panel
+    uint32_t frameBegin () const { return m_framebegin; }
+
+    /// @brief Get a row of the shown page as character/attribute pairs
+    const uint8_t *shownRow (coord_t y) const { return m_pages[m_showpage][y][0]; }
+
+#ifdef ST7735_CAPTURE
+    /// @brief Get the number of bytes sent to the panel by the last frame,
+    ///        i.e. since the previous render() or final renderSlice()
+    uint32_t frameBytes () const { return m_framebytes; }
+#endif
+
 protected:
+    typedef uint8_t page_t[TFB_ROWS][TFB_COLS][2];
+
+    static uint32_t span_mask (coord_t x0, coord_t x1) 
+    { return (x1 > x0) ? (0xFFFFFFFFu >> (32 - (x1 - x0))) << x0 : 0; }
     void dirty_update (coord_t x0, coord_t y0, coord_t x1, coord_t y1);
     void dirty_clean ();
+    void render_rect (const rect_t &r);
 
 protected:
     static TextFrameBuffer *s_singleton;
     static color_t s_palette[16][2];        ///< 16 color palette
 
-    uint8_t m_buf[ST7735_SCRHEIGHT][ST7735_SCRWIDTH][2];
-    struct rect_t  m_dirty;
+    page_t         m_pages[TFB_PAGES];      ///< character and attribute pages
+    uint8_t      (*m_buf)[TFB_COLS][2];     ///< page selected for drawing
+    uint32_t       m_dirty[TFB_ROWS];       ///< dirty cell bits per shown row
+    coord_t        m_cols;                  ///< text columns in current rotation
+    coord_t        m_rows;                  ///< text rows in current rotation
+    uint8_t        m_drawpage;              ///< page index selected for drawing
+    uint8_t        m_showpage;              ///< page index shown on the glass
     uint8_t        m_at;
+    uint8_t        m_glyphs[TFB_GLYPHS][FONTHEIGHT];    ///< RAM glyph rows
+    mirror_fn_t    m_mirror;                ///< rendered rows hook, or 0
+    bool           m_framerows;             ///< current frame sent rows
+    uint32_t       m_frames;                ///< frames that sent rows
+    uint32_t       m_framestamp;            ///< cycles() at end of last frame
+    uint32_t       m_framebegin;            ///< cycles() at start of last frame
+    uint32_t       m_passstart;             ///< cycles() at start of this frame
+    coord_t        m_slicerow;              ///< row the next slice starts at
+#ifdef ST7735_CAPTURE
+    uint32_t       m_framestart;            ///< capturedBytes() after last render()
+    uint32_t       m_framebytes;            ///< bytes sent by last render()
+#endif
 };
 
 
@@ -0,0 +1,138 @@
+/// @file analyze.cpp
+/// @brief Audio input analysis driving the output channel levels
+
+#include "Arduino.h"
+#include "cycles.hpp"
+#include "analyze.hpp"
+
+#define ANALYZE_TC TC0          // trigger timer
+#define ANALYZE_TC_CH 1         // TIOA1 is ADC trigger 2
+#define ANALYZE_TC_ID ID_TC1
+#define DC_SHIFT 12             // input offset tracking time constant
+
+CAnalyzer CAnalyzer::s_singleton;
+
+void 
+ADC_Handler ()
+{
+    CAnalyzer::get ()->interrupt ();
+}
+
+void
+CAnalyzer::interrupt ()
+{
+    if (!(ADC->ADC_ISR & ADC_ISR_ENDRX)) return;
+    uint32_t stamp = cycles ();
+    const uint16_t *src = m_buf[m_next];
+    uint16_t n = m_size[m_next];
+
+    // remove the bias, scale 12 bit to Q15 and split into bands
+    for (uint16_t i = 0; i < n; ++i) {
+        int32_t x = (int32_t) (src[i] & 0x0FFF) << 16;
+        m_dc += (x - m_dc) >> DC_SHIFT;
+        m_bank.push ((x - m_dc) >> 12);
+    }
+
+    // channel levels as weighted band sums
+    for (uint8_t ch = 0; ch < SYNTH_CHANNELS; ++ch) {
+        uint32_t level = 0;
+        for (uint8_t b = 0; b < BANK_BANDS; ++b)
+            level += ((uint32_t) m_bank.envelope (b) * m_gain[ch][b]) >> 15;
+        // the refill interrupt may preempt this one between the stores,
+        // so publish the stamp last: a stamp read is never newer than 
+        // the level read after it
+        m_out[ch].level = (level > 32768) ? 32768 : level;
+        __sync_synchronize ();
+        m_out[ch].stamp = stamp;
+    }
+
+    // queue the analyzed buffer behind the one being filled
+    m_size[m_next] = m_block;
+    ADC->ADC_RNPR = (uint32_t) m_buf[m_next];
+    ADC->ADC_RNCR = m_block;
+    m_next = 1 - m_next;
+}
+
+void
+CAnalyzer::begin (uint8_t adcch, uint32_t rate, uint16_t block)
+{
+    m_rate = rate;
+    m_block = constrain (block, 1, ANALYZE_MAXBLOCK);
+    m_size[0] = m_size[1] = m_block;
+    m_next = 0;
+    m_dc = (int32_t) 2048 << 16;
+    m_bank.configure (rate, 5, 100);
+    cycles_begin ();
+
+    pmc_enable_periph_clk (ID_ADC);
+    ADC->ADC_CR = ADC_CR_SWRST;
+    ADC->ADC_MR = ADC_MR_TRGEN_EN 
+                | ADC_MR_TRGSEL_ADC_TRIG2
+                | ADC_MR_PRESCAL (1)
+                | ADC_MR_STARTUP_SUT64
+                | ADC_MR_TRACKTIM (1)
+                | ADC_MR_TRANSFER (1);
+    ADC->ADC_CHER = 1 << adcch;
+
+    // PDC ping-pong as in CSynth
+    ADC->ADC_PTCR = PERIPH_PTCR_RXTDIS;
+    ADC->ADC_RPR = (uint32_t) m_buf[0];
+    ADC->ADC_RCR = m_block;
+    ADC->ADC_RNPR = (uint32_t) m_buf[1];
+    ADC->ADC_RNCR = m_block;
+    ADC->ADC_IER = ADC_IER_ENDRX;
+    // below the output refill, which must never wait for analysis
+    NVIC_SetPriority (ADC_IRQn, 2);
+    NVIC_EnableIRQ (ADC_IRQn);
+    ADC->ADC_PTCR = PERIPH_PTCR_RXTEN;
+
+    pmc_enable_periph_clk (ANALYZE_TC_ID);
+    TC_Configure (ANALYZE_TC, ANALYZE_TC_CH, 
+                  TC_CMR_TCCLKS_TIMER_CLOCK1 | TC_CMR_WAVE | TC_CMR_WAVSEL_UP_RC 
+                | TC_CMR_ACPA_CLEAR | TC_CMR_ACPC_SET);
+    uint32_t rc = VARIANT_MCK / 2 / rate;
+    TC_SetRC (ANALYZE_TC, ANALYZE_TC_CH, rc);
+    TC_SetRA (ANALYZE_TC, ANALYZE_TC_CH, rc / 2);
+    TC_Start (ANALYZE_TC, ANALYZE_TC_CH);
+}
+
+void
+CAnalyzer::end ()
+{
+    TC_Stop (ANALYZE_TC, ANALYZE_TC_CH);
+    ADC->ADC_IDR = ADC_IDR_ENDRX;
+    ADC->ADC_PTCR = PERIPH_PTCR_RXTDIS;
+    NVIC_DisableIRQ (ADC_IRQn);
+}
+
+void
+CAnalyzer::setBlock (uint16_t block)
+{
+    m_block = constrain (block, 1, ANALYZE_MAXBLOCK);
+}
+
+void
+CAnalyzer::setTimes (uint32_t attackms, uint32_t releasems)
+{
+    NVIC_DisableIRQ (ADC_IRQn);
+    m_bank.configure (m_rate, attackms, releasems);
+    NVIC_EnableIRQ (ADC_IRQn);
+}
+
+uint32_t
+CAnalyzer::latency (uint8_t ch, bool worst) const
+{
+    uint32_t capture = (uint32_t) m_block * 1000000 / m_rate;
+    uint32_t wait = (worst ? m_out[ch].maxdelay : m_out[ch].delay) / CYCLES_PER_US;
+    uint32_t output = 2UL * SYNTH_BLOCK * 1000000 / CSynth::get ()->rate ();
+    return capture + wait + output;
+}
+
+CAnalyzer::CAnalyzer ()
+: m_dc (0), m_rate (ANALYZE_RATE), m_block (64), m_next (0)
+{
+    memset (m_buf, 0, sizeof (m_buf));
+    memset (m_gain, 0, sizeof (m_gain));
+    memset (m_out, 0, sizeof (m_out));
+    m_size[0] = m_size[1] = m_block;
+}
@@ -0,0 +1,90 @@
+/// @file analyze.hpp
+/// @brief Audio input analysis driving the output channel levels
+
+#ifndef _ANALYZE_HPP_
+#define _ANALYZE_HPP_
+
+#include "filterbank.hpp"
+#include "synth.hpp"
+
+#ifndef ANALYZE_RATE
+#define ANALYZE_RATE 16000      ///< default ADC sample rate in Hz
+#endif
+
+#define ANALYZE_MAXBLOCK 256    ///< largest ADC block in samples
+
+/// @brief Class sampling the audio input via ADC PDC into ping-pong buffers
+///        and following the band envelopes of a CFilterBank. Each output 
+///        channel level is a weighted sum of band envelopes, exposed as a
+///        mod_source_t for CModulator::follow(). The block size trades 
+///        interrupt load for latency: a sample waits up to one block before
+///        it is analyzed.
+class CAnalyzer {
+public:
+    /// @brief Return the singleton CAnalyzer object
+    /// @return Pointer to the singleton CAnalyzer object
+    static CAnalyzer *get () { return &s_singleton; }
+
+    /// @brief Start sampling
+    /// @param adcch  ADC channel of the audio input, e.g. 7 for pin A0
+    /// @param rate   Sample rate in Hz
+    /// @param block  Samples per block, @see setBlock
+    void begin (uint8_t adcch, uint32_t rate = ANALYZE_RATE, uint16_t block = 64);
+
+    /// @brief Stop sampling and the trigger timer
+    void end ();
+
+    /// @brief Set the block size, taking effect with the next buffer
+    /// @param block  Samples per block, 1 <= block <= ANALYZE_MAXBLOCK
+    void setBlock (uint16_t block);
+
+    /// @brief Get the block size
+    uint16_t block () const { return m_block; }
+
+    /// @brief Set the envelope follower times of all bands
+    /// @param attackms   Attack time constant in ms
+    /// @param releasems  Release time constant in ms
+    void setTimes (uint32_t attackms, uint32_t releasems);
+
+    /// @brief Set how much a band contributes to an output channel level
+    /// @param band  Band, 0 <= band < BANK_BANDS, highest octave first
+    /// @param ch    Output channel, 0 <= ch < SYNTH_CHANNELS
+    /// @param gain  Q15 gain, 0 to disconnect
+    void map (uint8_t band, uint8_t ch, uint16_t gain) { m_gain[ch][band] = gain; }
+
+    /// @brief Get the level source of an output channel, to be passed to
+    ///        CSynth::get ()->modulator (ch).follow ()
+    mod_source_t *source (uint8_t ch) { return &m_out[ch]; }
+
+    /// @brief Get the band envelope
+    uint16_t envelope (uint8_t band) const { return m_bank.envelope (band); }
+
+    /// @brief Get the input to output latency of a channel in us: one 
+    ///        block of capture, the measured wait until the synthesizer
+    ///        took the level, and two synthesizer blocks of output queue
+    /// @param ch     Output channel
+    /// @param worst  Whether to use the largest measured wait
+    uint32_t latency (uint8_t ch, bool worst = false) const;
+
+    /// @brief ADC end-of-receive interrupt, called from ADC_Handler
+    void interrupt ();
+
+protected:
+    /// @brief Default constructor
+    CAnalyzer ();
+
+protected:
+    static CAnalyzer s_singleton;       ///< The singleton analyzer object
+
+    CFilterBank m_bank;                 ///< octave bands of the input
+    uint16_t m_buf[2][ANALYZE_MAXBLOCK];///< PDC ping-pong buffers
+    uint16_t m_gain[SYNTH_CHANNELS][BANK_BANDS]; ///< Q15 band to channel gains
+    mod_source_t m_out[SYNTH_CHANNELS]; ///< channel levels
+    int32_t  m_dc;                      ///< Q16 input offset tracked
+    uint32_t m_rate;                    ///< sample rate
+    volatile uint16_t m_block;          ///< block size of queued buffers
+    uint16_t m_size[2];                 ///< block size per buffer
+    uint8_t  m_next;                    ///< buffer filled next
+};
+
+#endif // _ANALYZE_HPP_
@@ -0,0 +1,26 @@
+/// @file cycles.hpp
+/// @brief Timestamps from the Cortex-M3 DWT cycle counter
+
+#ifndef _CYCLES_HPP_
+#define _CYCLES_HPP_
+
+#include "Arduino.h"
+
+#define CYCLES_PER_US (VARIANT_MCK / 1000000)  ///< cycle counter ticks per us
+
+/// @brief Start the free-running cycle counter; safe to call repeatedly
+inline void
+cycles_begin ()
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/// @brief Get the cycle counter; wraps after 51 s at 84 MHz
+inline uint32_t
+cycles ()
+{
+    return DWT->CYCCNT;
+}
+
+#endif // _CYCLES_HPP_
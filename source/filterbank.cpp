@@ -0,0 +1,63 @@
+/// @file filterbank.cpp
+/// @brief Decimating octave filter bank with per-band envelope followers
+
+#include <string.h>
+#include "filterbank.hpp"
+
+CFilterBank::CFilterBank ()
+: m_have (0)
+{
+    memset (m_hold, 0, sizeof (m_hold));
+    memset (m_env, 0, sizeof (m_env));
+    configure (1000, 1, 1);
+}
+
+/// @brief Q16 one-pole coefficient for a time constant at a rate
+static uint16_t
+coefficient (uint32_t rate, uint32_t ms)
+{
+    uint32_t n = (rate * ms + 500) / 1000;
+    return (n > 1) ? 65536 / n : 65535;
+}
+
+void
+CFilterBank::configure (uint32_t rate, uint32_t attackms, uint32_t releasems)
+{
+    // band b is updated at rate / 2^(b+1), the last one as the one before
+    for (uint8_t b = 0; b < BANK_BANDS; ++b) {
+        uint32_t r = rate >> ((b < BANK_BANDS-1) ? b+1 : b);
+        m_attack[b] = coefficient (r, attackms);
+        m_release[b] = coefficient (r, releasems);
+    }
+}
+
+void
+CFilterBank::follow (uint8_t band, int32_t x)
+{
+    // rectify and smooth, rising with the attack and falling with the 
+    // release coefficient
+    uint32_t a = (uint32_t) ((x < 0) ? -x : x) << 16;
+    uint32_t &env = m_env[band];
+    if (a > env)
+        env += (uint32_t) (((uint64_t) (a - env) * m_attack[band]) >> 16);
+    else
+        env -= (uint32_t) (((uint64_t) (env - a) * m_release[band]) >> 16);
+}
+
+void
+CFilterBank::push (int32_t x)
+{
+    for (uint8_t b = 0; b < BANK_BANDS-1; ++b) {
+        if (!(m_have & (1 << b))) {
+            m_hold[b] = x;
+            m_have |= (1 << b);
+            return;
+        }
+        m_have &= ~(1 << b);
+        // Haar split: the difference is the upper octave, the mean is 
+        // passed on at half the rate
+        follow (b, (m_hold[b] - x) >> 1);
+        x = (m_hold[b] + x) >> 1;
+    }
+    follow (BANK_BANDS-1, x);
+}
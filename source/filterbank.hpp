@@ -0,0 +1,46 @@
+/// @file filterbank.hpp
+/// @brief Decimating octave filter bank with per-band envelope followers
+
+#ifndef _FILTERBANK_HPP_
+#define _FILTERBANK_HPP_
+
+#include <stdint.h>
+
+#define BANK_BANDS 5            ///< octave bands, highest first
+
+/// @brief Class splitting a signal into octaves with a Haar wavelet cascade.
+///        Each stage halves the rate, so the whole bank costs less than two
+///        stages at the input rate. Band b covers fs/2^(b+2)..fs/2^(b+1), 
+///        the last band everything below.
+class CFilterBank {
+public:
+    /// @brief Default constructor
+    CFilterBank ();
+
+    /// @brief Set the envelope follower times
+    /// @param rate       Input sample rate in Hz
+    /// @param attackms   Attack time constant in ms
+    /// @param releasems  Release time constant in ms
+    void configure (uint32_t rate, uint32_t attackms, uint32_t releasems);
+
+    /// @brief Feed one input sample
+    /// @param x  Q15 sample
+    void push (int32_t x);
+
+    /// @brief Get the envelope of a band
+    /// @param band  Band, 0 <= band < BANK_BANDS
+    /// @return      Q15 envelope
+    uint16_t envelope (uint8_t band) const { return m_env[band] >> 16; }
+
+protected:
+    void follow (uint8_t band, int32_t x);
+
+protected:
+    int32_t  m_hold[BANK_BANDS-1];  ///< first sample of a pair per stage
+    uint8_t  m_have;                ///< bit per stage: m_hold is valid
+    uint32_t m_env[BANK_BANDS];     ///< Q31 envelopes
+    uint16_t m_attack[BANK_BANDS];  ///< Q16 attack coefficient per band
+    uint16_t m_release[BANK_BANDS]; ///< Q16 release coefficient per band
+};
+
+#endif // _FILTERBANK_HPP_
@@ -0,0 +1,126 @@
+/// @file font.hpp
+/// @brief Storage layouts of the 6x8 font and their decode kernels
+///
+/// The font source, font6x8H.i, lists each character as FONT_GLYPH() of
+/// its pixel rows. Defining FONT_GLYPH as one of the FONT_xxx_GLYPH 
+/// macros before including it transcodes the rows at compile time:
+///
+///     layout       bytes  decode per glyph
+///     FONT_ROWS    2048   none, rows are read in place
+///     FONT_COLS    1536   transpose of 6 column bytes
+///     FONT_PACK6   1536   shifts of two 24-bit words
+///
+/// Select the layout with -DFONT_LAYOUT=FONT_COLS etc.; host/font_bench
+/// measures the decode cost of each.
+
+#ifndef _FONT_HPP_
+#define _FONT_HPP_
+
+#include <stdint.h>
+
+#define FONTWIDTH 6     ///< Pixel width of a character; tight
+#define FONTHEIGHT 8    ///< Pixel height of a character; tight
+
+#define FONT_ROWS 0     ///< one byte per pixel row, leftmost pixel in bit 0
+#define FONT_COLS 1     ///< one byte per pixel column, top pixel in bit 0
+#define FONT_PACK6 2    ///< 6-bit rows packed into 6 bytes, top row first
+
+#ifndef FONT_LAYOUT
+#define FONT_LAYOUT FONT_ROWS
+#endif
+
+/// @brief Glyph bytes in FONT_ROWS layout
+#define FONT_ROWS_GLYPH(r0, r1, r2, r3, r4, r5, r6, r7) \
+    r0, r1, r2, r3, r4, r5, r6, r7,
+
+/// @brief Column i of a glyph given by its rows
+#define FONT_COL(i, r0, r1, r2, r3, r4, r5, r6, r7) \
+    (uint8_t) ((((r0) >> (i)) & 1)      | ((((r1) >> (i)) & 1) << 1) \
+             | ((((r2) >> (i)) & 1) << 2) | ((((r3) >> (i)) & 1) << 3) \
+             | ((((r4) >> (i)) & 1) << 4) | ((((r5) >> (i)) & 1) << 5) \
+             | ((((r6) >> (i)) & 1) << 6) | ((((r7) >> (i)) & 1) << 7))
+
+/// @brief Glyph bytes in FONT_COLS layout
+#define FONT_COLS_GLYPH(r0, r1, r2, r3, r4, r5, r6, r7) \
+    FONT_COL (0, r0, r1, r2, r3, r4, r5, r6, r7), \
+    FONT_COL (1, r0, r1, r2, r3, r4, r5, r6, r7), \
+    FONT_COL (2, r0, r1, r2, r3, r4, r5, r6, r7), \
+    FONT_COL (3, r0, r1, r2, r3, r4, r5, r6, r7), \
+    FONT_COL (4, r0, r1, r2, r3, r4, r5, r6, r7), \
+    FONT_COL (5, r0, r1, r2, r3, r4, r5, r6, r7),
+
+/// @brief Glyph bytes in FONT_PACK6 layout, rows 0-3 and 4-7 in two 
+///        little-endian 24-bit words
+#define FONT_PACK6_GLYPH(r0, r1, r2, r3, r4, r5, r6, r7) \
+    (uint8_t) ((r0) | ((r1) << 6)), (uint8_t) (((r1) >> 2) | ((r2) << 4)), \
+    (uint8_t) (((r2) >> 4) | ((r3) << 2)), \
+    (uint8_t) ((r4) | ((r5) << 6)), (uint8_t) (((r5) >> 2) | ((r6) << 4)), \
+    (uint8_t) (((r6) >> 4) | ((r7) << 2)),
+
+/// @brief Get the rows of a FONT_ROWS glyph
+/// @param font  Font bytes
+/// @param c     Character code
+/// @return      FONTHEIGHT rows, leftmost pixel in bit 0
+inline const uint8_t *
+font_rows_glyph (const uint8_t *font, uint8_t c, uint8_t *)
+{
+    return font + c * FONTHEIGHT;
+}
+
+/// @brief Decode the rows of a FONT_COLS glyph
+/// @param font  Font bytes
+/// @param c     Character code
+/// @param rows  Buffer of FONTHEIGHT bytes to decode into
+/// @return      rows
+inline const uint8_t *
+font_cols_glyph (const uint8_t *font, uint8_t c, uint8_t *rows)
+{
+    const uint8_t *col = font + c * FONTWIDTH;
+    // gather bit j of every column, two rows per 32-bit lane pass
+    uint32_t lo = 0, hi = 0;
+    for (uint8_t i = 0; i < FONTWIDTH; ++i) {
+        uint32_t b = col[i];
+        // spread bits 0-3 and 4-7 to bytes 0-3 at bit position i
+        lo |= (((b & 0x0F) * 0x00204081) & 0x01010101) << i;
+        hi |= ((((b >> 4) & 0x0F) * 0x00204081) & 0x01010101) << i;
+    }
+    rows[0] = lo; rows[1] = lo >> 8; rows[2] = lo >> 16; rows[3] = lo >> 24;
+    rows[4] = hi; rows[5] = hi >> 8; rows[6] = hi >> 16; rows[7] = hi >> 24;
+    return rows;
+}
+
+/// @brief Decode the rows of a FONT_PACK6 glyph
+/// @param font  Font bytes
+/// @param c     Character code
+/// @param rows  Buffer of FONTHEIGHT bytes to decode into
+/// @return      rows
+inline const uint8_t *
+font_pack6_glyph (const uint8_t *font, uint8_t c, uint8_t *rows)
+{
+    const uint8_t *p = font + c * 6;
+    uint32_t lo = p[0] | (p[1] << 8) | (p[2] << 16);
+    uint32_t hi = p[3] | (p[4] << 8) | (p[5] << 16);
+    rows[0] = lo & 0x3F; rows[1] = (lo >> 6) & 0x3F; 
+    rows[2] = (lo >> 12) & 0x3F; rows[3] = lo >> 18;
+    rows[4] = hi & 0x3F; rows[5] = (hi >> 6) & 0x3F; 
+    rows[6] = (hi >> 12) & 0x3F; rows[7] = hi >> 18;
+    return rows;
+}
+
+#if (FONT_LAYOUT == FONT_ROWS)
+#define FONT_GLYPH FONT_ROWS_GLYPH
+#define FONT_GLYPHBYTES FONTHEIGHT
+#define font_glyph font_rows_glyph
+#elif (FONT_LAYOUT == FONT_COLS)
+#define FONT_GLYPH FONT_COLS_GLYPH
+#define FONT_GLYPHBYTES FONTWIDTH
+#define font_glyph font_cols_glyph
+#elif (FONT_LAYOUT == FONT_PACK6)
+#define FONT_GLYPH FONT_PACK6_GLYPH
+#define FONT_GLYPHBYTES 6
+#define font_glyph font_pack6_glyph
+#else
+#error "FONT_LAYOUT must be FONT_ROWS, FONT_COLS or FONT_PACK6"
+#endif
+
+#endif // _FONT_HPP_
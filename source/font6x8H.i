@@ -1,267 +1,262 @@
 /// @file font6x8H.i
-/// @brief A customized 6x8 pixel character font, to be included in ST7735.cpp
-/// Stored row-wise. Column-wise storage would save 25% of storage but is slower
-/// to access during scaline-wise rendering of the text frame buffer.
+/// @brief A customized 6x8 pixel character font, to be included by ST7735.cpp
+/// One FONT_GLYPH() per character, its pixel rows top to bottom with the
+/// leftmost pixel in bit 0. The includer defines FONT_GLYPH to transcode 
+/// the rows to the storage layout at compile time, @see font.hpp
 
-#define FONTWIDTH 6     ///< Pixel width of a character; tight
-#define FONTHEIGHT 8    ///< Pixel height of a character; tight
-
-///< Bitmap font, 1 byte per row, 8 bytes per character
-const uint8_t Adafruit_ST7735::font[] = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  //   0x00 000
-    0x10, 0x00, 0x00, 0x01, 0x11, 0x12, 0x0c, 0x1f,  //   0x01 001
-    0x1f, 0x06, 0x09, 0x11, 0x00, 0x00, 0x00, 0x00,  //   0x02 002
-    0x14, 0x1e, 0x14, 0x00, 0x0a, 0x0a, 0x0a, 0x1f,  //   0x03 003
-    0x00, 0x01, 0x00, 0x00, 0x01, 0x01, 0x01, 0x1f,  //   0x04 004
-    0x14, 0x1c, 0x14, 0x14, 0x00, 0x18, 0x04, 0x00,  //   0x05 005
-    0x00, 0x0e, 0x04, 0x0e, 0x00, 0x00, 0x09, 0x06,  //   0x06 006
-    0x08, 0x1c, 0x08, 0x00, 0x1c, 0x04, 0x04, 0x07,  //   0x07 007
-    0x02, 0x07, 0x02, 0x00, 0x07, 0x04, 0x04, 0x1c,  //   0x08 008
-    0x00, 0x00, 0x04, 0x0a, 0x0a, 0x04, 0x00, 0x00,  //   0x09 009
-    0x1f, 0x1f, 0x1b, 0x15, 0x15, 0x1b, 0x1f, 0x1f,  //   0x0a 010
-    0x00, 0x1c, 0x18, 0x16, 0x05, 0x05, 0x02, 0x00,  //   0x0b 011
-    0x0e, 0x11, 0x11, 0x0e, 0x04, 0x1f, 0x04, 0x00,  //   0x0c 012
-    0x1e, 0x12, 0x1e, 0x02, 0x02, 0x02, 0x03, 0x00,  //   0x0d 013
-    0x1e, 0x12, 0x1e, 0x12, 0x12, 0x1a, 0x03, 0x00,  //   0x0e 014
-    0x04, 0x15, 0x0e, 0x1b, 0x1b, 0x0e, 0x15, 0x04,  //   0x0f 015
-    0x01, 0x03, 0x0f, 0x1f, 0x0f, 0x03, 0x01, 0x00,  // > 0x10 016
-    0x10, 0x18, 0x1e, 0x1f, 0x1e, 0x18, 0x10, 0x00,  // < 0x11 017
-    0x04, 0x0e, 0x15, 0x04, 0x15, 0x0e, 0x04, 0x00,  //   0x12 018
-    0x1b, 0x1b, 0x1b, 0x1b, 0x1b, 0x00, 0x1b, 0x00,  //   0x13 019
-    0x1e, 0x15, 0x15, 0x16, 0x14, 0x14, 0x14, 0x00,  //   0x14 020
-    0x0c, 0x12, 0x0a, 0x14, 0x08, 0x12, 0x12, 0x0c,  //   0x15 021
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x1f, 0x00,  //   0x16 022
-    0x04, 0x0e, 0x15, 0x04, 0x15, 0x0e, 0x04, 0x1f,  //   0x17 023
-    0x00, 0x04, 0x0e, 0x15, 0x04, 0x04, 0x04, 0x00,  //   0x18 024
-    0x00, 0x04, 0x04, 0x04, 0x15, 0x0e, 0x04, 0x00,  //   0x19 025
-    0x00, 0x04, 0x08, 0x1f, 0x08, 0x04, 0x00, 0x00,  //   0x1a 026
-    0x00, 0x04, 0x02, 0x1f, 0x02, 0x04, 0x00, 0x00,  //   0x1b 027
-    0x00, 0x01, 0x01, 0x01, 0x1f, 0x00, 0x00, 0x00,  //   0x1c 028
-    0x00, 0x0a, 0x1f, 0x1f, 0x0a, 0x00, 0x00, 0x00,  //   0x1d 029
-    0x00, 0x04, 0x04, 0x0e, 0x1f, 0x1f, 0x00, 0x00,  //   0x1e 030
-    0x00, 0x1f, 0x1f, 0x0e, 0x04, 0x04, 0x00, 0x00,  //   0x1f 031
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  //   0x20 032
-    0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04, 0x00,  // ! 0x21 033
-    0x0a, 0x0a, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00,  // " 0x22 034
-    0x0a, 0x0a, 0x1f, 0x0a, 0x1f, 0x0a, 0x0a, 0x00,  // # 0x23 035
-    0x04, 0x1e, 0x05, 0x0e, 0x14, 0x0f, 0x04, 0x00,  // $ 0x24 036
-    0x03, 0x13, 0x08, 0x04, 0x02, 0x19, 0x18, 0x00,  // % 0x25 037
-    0x02, 0x05, 0x05, 0x02, 0x15, 0x09, 0x16, 0x00,  // & 0x26 038
-    0x0c, 0x0c, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00,  // ' 0x27 039
-    0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08, 0x00,  // ( 0x28 040
-    0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02, 0x00,  // ) 0x29 041
-    0x04, 0x15, 0x0e, 0x1f, 0x0e, 0x15, 0x04, 0x00,  // * 0x2a 042
-    0x00, 0x04, 0x04, 0x1f, 0x04, 0x04, 0x00, 0x00,  // + 0x2b 043
-    0x00, 0x00, 0x00, 0x00, 0x0c, 0x0c, 0x04, 0x02,  // , 0x2c 044
-    0x00, 0x00, 0x00, 0x1f, 0x00, 0x00, 0x00, 0x00,  // - 0x2d 045
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x0c, 0x00,  // . 0x2e 046
-    0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00,  // / 0x2f 047
-    0x0e, 0x11, 0x19, 0x15, 0x13, 0x11, 0x0e, 0x00,  // 0 0x30 048
-    0x04, 0x06, 0x04, 0x04, 0x04, 0x04, 0x0e, 0x00,  // 1 0x31 049
-    0x0e, 0x11, 0x10, 0x0e, 0x01, 0x01, 0x1f, 0x00,  // 2 0x32 050
-    0x1f, 0x10, 0x08, 0x0c, 0x10, 0x11, 0x0e, 0x00,  // 3 0x33 051
-    0x08, 0x0c, 0x0a, 0x09, 0x1f, 0x08, 0x08, 0x00,  // 4 0x34 052
-    0x1f, 0x01, 0x0f, 0x10, 0x10, 0x11, 0x0e, 0x00,  // 5 0x35 053
-    0x1c, 0x02, 0x01, 0x0f, 0x11, 0x11, 0x0e, 0x00,  // 6 0x36 054
-    0x1f, 0x10, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00,  // 7 0x37 055
-    0x0e, 0x11, 0x11, 0x0e, 0x11, 0x11, 0x0e, 0x00,  // 8 0x38 056
-    0x0e, 0x11, 0x11, 0x1e, 0x10, 0x08, 0x07, 0x00,  // 9 0x39 057
-    0x00, 0x00, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00,  // : 0x3a 058
-    0x00, 0x00, 0x04, 0x00, 0x04, 0x04, 0x02, 0x00,  // ; 0x3b 059
-    0x10, 0x08, 0x04, 0x02, 0x04, 0x08, 0x10, 0x00,  // < 0x3c 060
-    0x00, 0x00, 0x1f, 0x00, 0x1f, 0x00, 0x00, 0x00,  // = 0x3d 061
-    0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02, 0x00,  // > 0x3e 062
-    0x0e, 0x11, 0x10, 0x0c, 0x04, 0x00, 0x04, 0x00,  // ? 0x3f 063
-    0x0e, 0x11, 0x15, 0x1d, 0x0d, 0x01, 0x1e, 0x00,  // @ 0x40 064
-    0x04, 0x0a, 0x11, 0x11, 0x1f, 0x11, 0x11, 0x00,  // A 0x41 065
-    0x0f, 0x11, 0x11, 0x0f, 0x11, 0x11, 0x0f, 0x00,  // B 0x42 066
-    0x0e, 0x11, 0x01, 0x01, 0x01, 0x11, 0x0e, 0x00,  // C 0x43 067
-    0x0f, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0f, 0x00,  // D 0x44 068
-    0x1f, 0x01, 0x01, 0x0f, 0x01, 0x01, 0x1f, 0x00,  // E 0x45 069
-    0x1f, 0x01, 0x01, 0x0f, 0x01, 0x01, 0x01, 0x00,  // F 0x46 070
-    0x1e, 0x11, 0x01, 0x01, 0x19, 0x11, 0x1e, 0x00,  // G 0x47 071
-    0x11, 0x11, 0x11, 0x1f, 0x11, 0x11, 0x11, 0x00,  // H 0x48 072
-    0x0e, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0e, 0x00,  // I 0x49 073
-    0x1c, 0x08, 0x08, 0x08, 0x08, 0x09, 0x06, 0x00,  // J 0x4a 074
-    0x11, 0x09, 0x05, 0x03, 0x05, 0x09, 0x11, 0x00,  // K 0x4b 075
-    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x1f, 0x00,  // L 0x4c 076
-    0x11, 0x1b, 0x15, 0x15, 0x15, 0x11, 0x11, 0x00,  // M 0x4d 077
-    0x11, 0x11, 0x13, 0x15, 0x19, 0x11, 0x11, 0x00,  // N 0x4e 078
-    0x0e, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e, 0x00,  // O 0x4f 079
-    0x0f, 0x11, 0x11, 0x0f, 0x01, 0x01, 0x01, 0x00,  // P 0x50 080
-    0x0e, 0x11, 0x11, 0x11, 0x15, 0x09, 0x16, 0x00,  // Q 0x51 081
-    0x0f, 0x11, 0x11, 0x0f, 0x05, 0x09, 0x11, 0x00,  // R 0x52 082
-    0x0e, 0x11, 0x01, 0x0e, 0x10, 0x11, 0x0e, 0x00,  // S 0x53 083
-    0x1f, 0x15, 0x04, 0x04, 0x04, 0x04, 0x04, 0x00,  // T 0x54 084
-    0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e, 0x00,  // U 0x55 085
-    0x11, 0x11, 0x11, 0x11, 0x11, 0x0a, 0x04, 0x00,  // V 0x56 086
-    0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0a, 0x00,  // W 0x57 087
-    0x11, 0x11, 0x0a, 0x04, 0x0a, 0x11, 0x11, 0x00,  // X 0x58 088
-    0x11, 0x11, 0x0a, 0x04, 0x04, 0x04, 0x04, 0x00,  // Y 0x59 089
-    0x1f, 0x10, 0x08, 0x0e, 0x02, 0x01, 0x1f, 0x00,  // Z 0x5a 090
-    0x1e, 0x02, 0x02, 0x02, 0x02, 0x02, 0x1e, 0x00,  // [ 0x5b 091
-    0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00, 0x00,  // \ 0x5c 092
-    0x1e, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1e, 0x00,  // ] 0x5d 093
-    0x04, 0x0a, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00,  // ^ 0x5e 094
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x00,  // _ 0x5f 095
-    0x06, 0x06, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00,  // ` 0x60 096
-    0x00, 0x00, 0x06, 0x08, 0x0e, 0x09, 0x1e, 0x00,  // a 0x61 097
-    0x01, 0x01, 0x0d, 0x13, 0x11, 0x13, 0x0d, 0x00,  // b 0x62 098
-    0x00, 0x00, 0x0e, 0x11, 0x01, 0x11, 0x0e, 0x00,  // c 0x63 099
-    0x10, 0x10, 0x16, 0x19, 0x11, 0x19, 0x16, 0x00,  // d 0x64 100
-    0x00, 0x00, 0x0e, 0x11, 0x1f, 0x01, 0x0e, 0x00,  // e 0x65 101
-    0x08, 0x14, 0x04, 0x0e, 0x04, 0x04, 0x04, 0x00,  // f 0x66 102
-    0x00, 0x00, 0x0e, 0x19, 0x19, 0x16, 0x10, 0x0e,  // g 0x67 103
-    0x01, 0x01, 0x0d, 0x13, 0x11, 0x11, 0x11, 0x00,  // h 0x68 104
-    0x04, 0x00, 0x06, 0x04, 0x04, 0x04, 0x0e, 0x00,  // i 0x69 105
-    0x08, 0x00, 0x08, 0x08, 0x08, 0x09, 0x06, 0x00,  // j 0x6a 106
-    0x01, 0x01, 0x09, 0x05, 0x03, 0x05, 0x09, 0x00,  // k 0x6b 107
-    0x06, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0e, 0x00,  // l 0x6c 108
-    0x00, 0x00, 0x0b, 0x15, 0x15, 0x15, 0x15, 0x00,  // m 0x6d 109
-    0x00, 0x00, 0x0d, 0x13, 0x11, 0x11, 0x11, 0x00,  // n 0x6e 110
-    0x00, 0x00, 0x0e, 0x11, 0x11, 0x11, 0x0e, 0x00,  // o 0x6f 111
-    0x00, 0x00, 0x0d, 0x13, 0x13, 0x0d, 0x01, 0x01,  // p 0x70 112
-    0x00, 0x00, 0x16, 0x19, 0x19, 0x16, 0x10, 0x10,  // q 0x71 113
-    0x00, 0x00, 0x0d, 0x13, 0x01, 0x01, 0x01, 0x00,  // r 0x72 114
-    0x00, 0x00, 0x1e, 0x01, 0x0e, 0x10, 0x0f, 0x00,  // s 0x73 115
-    0x04, 0x04, 0x1f, 0x04, 0x04, 0x14, 0x08, 0x00,  // t 0x74 116
-    0x00, 0x00, 0x11, 0x11, 0x11, 0x19, 0x16, 0x00,  // u 0x75 117
-    0x00, 0x00, 0x11, 0x11, 0x11, 0x0a, 0x04, 0x00,  // v 0x76 118
-    0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0a, 0x00,  // w 0x77 119
-    0x00, 0x00, 0x11, 0x0a, 0x04, 0x0a, 0x11, 0x00,  // x 0x78 120
-    0x00, 0x00, 0x11, 0x11, 0x1e, 0x10, 0x11, 0x0e,  // y 0x79 121
-    0x00, 0x00, 0x1f, 0x08, 0x04, 0x02, 0x1f, 0x00,  // z 0x7a 122
-    0x08, 0x04, 0x04, 0x02, 0x04, 0x04, 0x08, 0x00,  // { 0x7b 123
-    0x04, 0x04, 0x04, 0x00, 0x04, 0x04, 0x04, 0x00,  // | 0x7c 124
-    0x02, 0x04, 0x04, 0x08, 0x04, 0x04, 0x02, 0x00,  // } 0x7d 125
-    0x02, 0x15, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00,  // ~ 0x7e 126
-    0x04, 0x0e, 0x1b, 0x11, 0x11, 0x1f, 0x00, 0x00,  //  0x7f 127
-    0x0e, 0x11, 0x01, 0x01, 0x11, 0x0e, 0x08, 0x06,  //  0x80 128
-    0x00, 0x11, 0x00, 0x11, 0x11, 0x19, 0x16, 0x00,  //  0x81 129
-    0x18, 0x00, 0x0e, 0x11, 0x1f, 0x01, 0x1e, 0x00,  //  0x82 130
-    0x1f, 0x00, 0x06, 0x08, 0x0e, 0x09, 0x1e, 0x00,  //  0x83 131
-    0x11, 0x00, 0x06, 0x08, 0x0e, 0x09, 0x1e, 0x00,  //  0x84 132
-    0x03, 0x00, 0x06, 0x08, 0x0e, 0x09, 0x1e, 0x00,  //  0x85 133
-    0x0c, 0x00, 0x06, 0x08, 0x0e, 0x09, 0x1e, 0x00,  //  0x86 134
-    0x00, 0x1e, 0x03, 0x03, 0x1e, 0x08, 0x0c, 0x00,  //  0x87 135
-    0x1f, 0x00, 0x0e, 0x11, 0x1f, 0x01, 0x1e, 0x00,  //  0x88 136
-    0x11, 0x00, 0x0e, 0x11, 0x1f, 0x01, 0x1e, 0x00,  //  0x89 137
-    0x03, 0x00, 0x0e, 0x11, 0x1f, 0x01, 0x1e, 0x00,  //  0x8a 138
-    0x14, 0x00, 0x0c, 0x08, 0x08, 0x08, 0x1c, 0x00,  //  0x8b 139
-    0x0c, 0x12, 0x0c, 0x08, 0x08, 0x08, 0x1c, 0x00,  //  0x8c 140
-    0x06, 0x00, 0x0c, 0x08, 0x08, 0x08, 0x1c, 0x00,  //  0x8d 141
-    0x0a, 0x00, 0x04, 0x0a, 0x11, 0x1f, 0x11, 0x11,  //  0x8e 142
-    0x04, 0x00, 0x04, 0x0a, 0x11, 0x1f, 0x11, 0x11,  //  0x8f 143
-    0x0c, 0x00, 0x0f, 0x01, 0x07, 0x01, 0x0f, 0x00,  //  0x90 144
-    0x00, 0x00, 0x1e, 0x08, 0x1e, 0x09, 0x1e, 0x00,  //  0x91 145
-    0x1c, 0x0a, 0x09, 0x1f, 0x09, 0x09, 0x19, 0x00,  //  0x92 146
-    0x0e, 0x11, 0x00, 0x0e, 0x11, 0x11, 0x0e, 0x00,  //  0x93 147
-    0x00, 0x11, 0x00, 0x0e, 0x11, 0x11, 0x0e, 0x00,  //  0x94 148
-    0x00, 0x03, 0x00, 0x0e, 0x11, 0x11, 0x0e, 0x00,  //  0x95 149
-    0x0e, 0x11, 0x00, 0x11, 0x11, 0x19, 0x16, 0x00,  //  0x96 150
-    0x00, 0x03, 0x00, 0x11, 0x11, 0x19, 0x16, 0x00,  //  0x97 151
-    0x12, 0x00, 0x12, 0x12, 0x12, 0x1c, 0x10, 0x0e,  //  0x98 152
-    0x11, 0x00, 0x0e, 0x11, 0x11, 0x11, 0x0e, 0x00,  //  0x99 153
-    0x11, 0x00, 0x11, 0x11, 0x11, 0x11, 0x0e, 0x00,  //  0x9a 154
-    0x04, 0x04, 0x1f, 0x05, 0x05, 0x1f, 0x04, 0x04,  //  0x9b 155
-    0x0c, 0x1a, 0x12, 0x07, 0x02, 0x12, 0x1f, 0x00,  //  0x9c 156
-    0x1b, 0x1b, 0x0e, 0x1f, 0x04, 0x1f, 0x04, 0x04,  //  0x9d 157
-    0x07, 0x09, 0x09, 0x07, 0x09, 0x1d, 0x09, 0x09,  //  0x9e 158
-    0x18, 0x14, 0x04, 0x0e, 0x04, 0x04, 0x05, 0x03,  //  0x9f 159
-    0x18, 0x00, 0x06, 0x08, 0x0e, 0x09, 0x1e, 0x00,  //  0xa0 160
-    0x18, 0x00, 0x0c, 0x08, 0x08, 0x08, 0x1c, 0x00,  //  0xa1 161
-    0x00, 0x18, 0x00, 0x0e, 0x11, 0x11, 0x0e, 0x00,  //  0xa2 162
-    0x00, 0x18, 0x00, 0x11, 0x11, 0x19, 0x16, 0x00,  //  0xa3 163
-    0x00, 0x1e, 0x00, 0x0e, 0x12, 0x12, 0x12, 0x00,  //  0xa4 164
-    0x1f, 0x00, 0x13, 0x17, 0x1d, 0x19, 0x11, 0x00,  //  0xa5 165
-    0x0e, 0x09, 0x09, 0x1e, 0x00, 0x1f, 0x00, 0x00,  //  0xa6 166
-    0x0e, 0x11, 0x11, 0x0e, 0x00, 0x1f, 0x00, 0x00,  //  0xa7 167
-    0x04, 0x00, 0x04, 0x06, 0x01, 0x11, 0x0e, 0x00,  //  0xa8 168
-    0x00, 0x00, 0x00, 0x1f, 0x01, 0x01, 0x00, 0x00,  //  0xa9 169
-    0x00, 0x00, 0x00, 0x1f, 0x10, 0x10, 0x00, 0x00,  //  0xaa 170
-    0x01, 0x11, 0x09, 0x1d, 0x12, 0x19, 0x04, 0x1c,  //  0xab 171
-    0x01, 0x11, 0x09, 0x15, 0x1a, 0x1d, 0x10, 0x10,  //  0xac 172
-    0x04, 0x04, 0x00, 0x04, 0x04, 0x04, 0x04, 0x00,  //  0xad 173
-    0x00, 0x14, 0x0a, 0x05, 0x0a, 0x14, 0x00, 0x00,  //  0xae 174
-    0x00, 0x05, 0x0a, 0x14, 0x0a, 0x05, 0x00, 0x00,  //  0xaf 175
-    0x04, 0x11, 0x04, 0x11, 0x04, 0x11, 0x04, 0x11,  //  0xb0 176
-    0x0a, 0x15, 0x0a, 0x15, 0x0a, 0x15, 0x0a, 0x15,  //  0xb1 177
-    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,  //  0xb2 178
-    0x08, 0x08, 0x08, 0x08, 0x0f, 0x08, 0x08, 0x08,  //  0xb3 179
-    0x08, 0x08, 0x0f, 0x08, 0x0f, 0x08, 0x08, 0x08,  //  0xb4 180
-    0x14, 0x14, 0x14, 0x14, 0x17, 0x14, 0x14, 0x14,  //  0xb5 181
-    0x00, 0x00, 0x00, 0x00, 0x1f, 0x14, 0x14, 0x14,  //  0xb6 182
-    0x00, 0x00, 0x0f, 0x08, 0x0f, 0x08, 0x08, 0x08,  //  0xb7 183
-    0x14, 0x14, 0x17, 0x10, 0x17, 0x14, 0x14, 0x14,  //  0xb8 184
-    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,  //  0xb9 185
-    0x00, 0x00, 0x1f, 0x10, 0x17, 0x14, 0x14, 0x14,  //  0xba 186
-    0x14, 0x14, 0x17, 0x10, 0x1f, 0x00, 0x00, 0x00,  //  0xbb 187
-    0x14, 0x14, 0x14, 0x14, 0x1f, 0x00, 0x00, 0x00,  //  0xbc 188
-    0x08, 0x08, 0x0f, 0x08, 0x0f, 0x00, 0x00, 0x00,  //  0xbd 189
-    0x00, 0x00, 0x00, 0x00, 0x0f, 0x08, 0x08, 0x08,  //  0xbe 190
-    0x08, 0x08, 0x08, 0x08, 0x38, 0x00, 0x00, 0x00,  //  0xbf 191
-    0x08, 0x08, 0x08, 0x08, 0x1f, 0x00, 0x00, 0x00,  //  0xc0 192
-    0x00, 0x00, 0x00, 0x00, 0x1f, 0x08, 0x08, 0x08,  //  0xc1 193
-    0x08, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x08,  //  0xc2 194
-    0x00, 0x00, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x00,  //  0xc3 195
-    0x08, 0x08, 0x08, 0x08, 0x1f, 0x08, 0x08, 0x08,  //  0xc4 196
-    0x08, 0x08, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08,  //  0xc5 197
-    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,  //  0xc6 198
-    0x14, 0x14, 0x14, 0x04, 0x1c, 0x00, 0x00, 0x00,  //  0xc7 199
-    0x00, 0x00, 0x1c, 0x04, 0x14, 0x14, 0x14, 0x14,  //  0xc8 200
-    0x14, 0x14, 0x17, 0x00, 0x1f, 0x00, 0x00, 0x00,  //  0xc9 201
-    0x00, 0x00, 0x1f, 0x00, 0x17, 0x14, 0x14, 0x14,  //  0xca 202
-    0x14, 0x14, 0x14, 0x04, 0x14, 0x14, 0x14, 0x14,  //  0xcb 203
-    0x00, 0x00, 0x1f, 0x00, 0x1f, 0x00, 0x00, 0x00,  //  0xcc 204
-    0x14, 0x14, 0x17, 0x00, 0x17, 0x14, 0x14, 0x14,  //  0xcd 205
-    0x08, 0x08, 0x1f, 0x00, 0x1f, 0x00, 0x00, 0x00,  //  0xce 206
-    0x14, 0x14, 0x14, 0x14, 0x1f, 0x00, 0x00, 0x00,  //  0xcf 207
-    0x00, 0x00, 0x1f, 0x00, 0x1f, 0x08, 0x08, 0x08,  //  0xd0 208
-    0x00, 0x00, 0x00, 0x00, 0x1f, 0x14, 0x14, 0x14,  //  0xd1 209
-    0x14, 0x14, 0x14, 0x14, 0x1c, 0x00, 0x00, 0x00,  //  0xd2 210
-    0x08, 0x08, 0x18, 0x08, 0x18, 0x00, 0x00, 0x00,  //  0xd3 211
-    0x00, 0x00, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08,  //  0xd4 212
-    0x00, 0x00, 0x00, 0x00, 0x1c, 0x14, 0x14, 0x14,  //  0xd5 213
-    0x14, 0x14, 0x14, 0x14, 0x1f, 0x14, 0x14, 0x14,  //  0xd6 214
-    0x08, 0x08, 0x1f, 0x08, 0x1f, 0x08, 0x08, 0x08,  //  0xd7 215
-    0x08, 0x08, 0x08, 0x08, 0x0f, 0x00, 0x00, 0x00,  //  0xd8 216
-    0x00, 0x00, 0x00, 0x00, 0x38, 0x08, 0x08, 0x08,  //  0xd9 217
-    0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f,  //  0xda 218
-    0x00, 0x00, 0x00, 0x00, 0x1f, 0x1f, 0x1f, 0x1f,  //  0xdb 219
-    0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,  //  0xdc 220
-    0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,  //  0xdd 221
-    0x1f, 0x1f, 0x1f, 0x1f, 0x00, 0x00, 0x00, 0x00,  //  0xde 222
-    0x00, 0x00, 0x16, 0x09, 0x09, 0x09, 0x16, 0x00,  //  0xdf 223
-    0x00, 0x0e, 0x19, 0x0f, 0x19, 0x0f, 0x01, 0x00,  //  0xe0 224
-    0x00, 0x1f, 0x19, 0x01, 0x01, 0x01, 0x01, 0x00,  //  0xe1 225
-    0x00, 0x1f, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x00,  //  0xe2 226
-    0x1f, 0x11, 0x02, 0x04, 0x02, 0x11, 0x1f, 0x00,  //  0xe3 227
-    0x00, 0x00, 0x1e, 0x09, 0x09, 0x09, 0x06, 0x00,  //  0xe4 228
-    0x00, 0x0a, 0x0a, 0x0a, 0x0a, 0x16, 0x03, 0x00,  //  0xe5 229
-    0x00, 0x1f, 0x05, 0x04, 0x04, 0x04, 0x04, 0x00,  //  0xe6 230
-    0x1f, 0x04, 0x0e, 0x11, 0x11, 0x0e, 0x04, 0x1f,  //  0xe7 231
-    0x04, 0x0a, 0x11, 0x1f, 0x11, 0x0a, 0x04, 0x00,  //  0xe8 232
-    0x04, 0x0a, 0x11, 0x11, 0x0a, 0x0a, 0x1b, 0x00,  //  0xe9 233
-    0x0c, 0x02, 0x0c, 0x0e, 0x11, 0x11, 0x0e, 0x00,  //  0xea 234
-    0x00, 0x00, 0x00, 0x0e, 0x15, 0x15, 0x0e, 0x00,  //  0xeb 235
-    0x10, 0x0e, 0x19, 0x15, 0x15, 0x13, 0x0e, 0x01,  //  0xec 236
-    0x0e, 0x01, 0x01, 0x0f, 0x01, 0x01, 0x0e, 0x00,  //  0xed 237
-    0x0e, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x00,  //  0xee 238
-    0x00, 0x1f, 0x00, 0x1f, 0x00, 0x1f, 0x00, 0x00,  //  0xef 239
-    0x04, 0x04, 0x1f, 0x04, 0x04, 0x00, 0x1f, 0x00,  //  0xf0 240
-    0x02, 0x04, 0x08, 0x04, 0x02, 0x00, 0x1f, 0x00,  //  0xf1 241
-    0x08, 0x04, 0x02, 0x04, 0x08, 0x00, 0x1f, 0x00,  //  0xf2 242
-    0x1c, 0x14, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,  //  0xf3 243
-    0x04, 0x04, 0x04, 0x04, 0x04, 0x05, 0x05, 0x07,  //  0xf4 244
-    0x0c, 0x0c, 0x00, 0x1f, 0x00, 0x0c, 0x0c, 0x00,  //  0xf5 245
-    0x00, 0x17, 0x1d, 0x00, 0x17, 0x1d, 0x00, 0x00,  //  0xf6 246
-    0x0e, 0x1b, 0x1b, 0x0e, 0x00, 0x00, 0x00, 0x00,  //  0xf7 247
-    0x00, 0x00, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00,  //  0xf8 248
-    0x00, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00,  //  0xf9 249
-    0x1c, 0x04, 0x04, 0x04, 0x05, 0x05, 0x06, 0x04,  //  0xfa 250
-    0x0e, 0x12, 0x12, 0x12, 0x12, 0x00, 0x00, 0x00,  //  0xfb 251
-    0x0e, 0x18, 0x0c, 0x06, 0x1e, 0x00, 0x00, 0x00,  //  0xfc 252
-    0x00, 0x00, 0x1e, 0x1e, 0x1e, 0x1e, 0x00, 0x00,  //  0xfd 253
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  //  0xfe 254
-    0x11, 0x19, 0x1b, 0x10, 0x03, 0x1b, 0x1b, 0x00,  //  0xff 255
-};
+FONT_GLYPH (0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00)  //   0x00 000
+FONT_GLYPH (0x10, 0x00, 0x00, 0x01, 0x11, 0x12, 0x0c, 0x1f)  //   0x01 001
+FONT_GLYPH (0x1f, 0x06, 0x09, 0x11, 0x00, 0x00, 0x00, 0x00)  //   0x02 002
+FONT_GLYPH (0x14, 0x1e, 0x14, 0x00, 0x0a, 0x0a, 0x0a, 0x1f)  //   0x03 003
+FONT_GLYPH (0x00, 0x01, 0x00, 0x00, 0x01, 0x01, 0x01, 0x1f)  //   0x04 004
+FONT_GLYPH (0x14, 0x1c, 0x14, 0x14, 0x00, 0x18, 0x04, 0x00)  //   0x05 005
+FONT_GLYPH (0x00, 0x0e, 0x04, 0x0e, 0x00, 0x00, 0x09, 0x06)  //   0x06 006
+FONT_GLYPH (0x08, 0x1c, 0x08, 0x00, 0x1c, 0x04, 0x04, 0x07)  //   0x07 007
+FONT_GLYPH (0x02, 0x07, 0x02, 0x00, 0x07, 0x04, 0x04, 0x1c)  //   0x08 008
+FONT_GLYPH (0x00, 0x00, 0x04, 0x0a, 0x0a, 0x04, 0x00, 0x00)  //   0x09 009
+FONT_GLYPH (0x1f, 0x1f, 0x1b, 0x15, 0x15, 0x1b, 0x1f, 0x1f)  //   0x0a 010
+FONT_GLYPH (0x00, 0x1c, 0x18, 0x16, 0x05, 0x05, 0x02, 0x00)  //   0x0b 011
+FONT_GLYPH (0x0e, 0x11, 0x11, 0x0e, 0x04, 0x1f, 0x04, 0x00)  //   0x0c 012
+FONT_GLYPH (0x1e, 0x12, 0x1e, 0x02, 0x02, 0x02, 0x03, 0x00)  //   0x0d 013
+FONT_GLYPH (0x1e, 0x12, 0x1e, 0x12, 0x12, 0x1a, 0x03, 0x00)  //   0x0e 014
+FONT_GLYPH (0x04, 0x15, 0x0e, 0x1b, 0x1b, 0x0e, 0x15, 0x04)  //   0x0f 015
+FONT_GLYPH (0x01, 0x03, 0x0f, 0x1f, 0x0f, 0x03, 0x01, 0x00)  // > 0x10 016
+FONT_GLYPH (0x10, 0x18, 0x1e, 0x1f, 0x1e, 0x18, 0x10, 0x00)  // < 0x11 017
+FONT_GLYPH (0x04, 0x0e, 0x15, 0x04, 0x15, 0x0e, 0x04, 0x00)  //   0x12 018
+FONT_GLYPH (0x1b, 0x1b, 0x1b, 0x1b, 0x1b, 0x00, 0x1b, 0x00)  //   0x13 019
+FONT_GLYPH (0x1e, 0x15, 0x15, 0x16, 0x14, 0x14, 0x14, 0x00)  //   0x14 020
+FONT_GLYPH (0x0c, 0x12, 0x0a, 0x14, 0x08, 0x12, 0x12, 0x0c)  //   0x15 021
+FONT_GLYPH (0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x1f, 0x00)  //   0x16 022
+FONT_GLYPH (0x04, 0x0e, 0x15, 0x04, 0x15, 0x0e, 0x04, 0x1f)  //   0x17 023
+FONT_GLYPH (0x00, 0x04, 0x0e, 0x15, 0x04, 0x04, 0x04, 0x00)  //   0x18 024
+FONT_GLYPH (0x00, 0x04, 0x04, 0x04, 0x15, 0x0e, 0x04, 0x00)  //   0x19 025
+FONT_GLYPH (0x00, 0x04, 0x08, 0x1f, 0x08, 0x04, 0x00, 0x00)  //   0x1a 026
+FONT_GLYPH (0x00, 0x04, 0x02, 0x1f, 0x02, 0x04, 0x00, 0x00)  //   0x1b 027
+FONT_GLYPH (0x00, 0x01, 0x01, 0x01, 0x1f, 0x00, 0x00, 0x00)  //   0x1c 028
+FONT_GLYPH (0x00, 0x0a, 0x1f, 0x1f, 0x0a, 0x00, 0x00, 0x00)  //   0x1d 029
+FONT_GLYPH (0x00, 0x04, 0x04, 0x0e, 0x1f, 0x1f, 0x00, 0x00)  //   0x1e 030
+FONT_GLYPH (0x00, 0x1f, 0x1f, 0x0e, 0x04, 0x04, 0x00, 0x00)  //   0x1f 031
+FONT_GLYPH (0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00)  //   0x20 032
+FONT_GLYPH (0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04, 0x00)  // ! 0x21 033
+FONT_GLYPH (0x0a, 0x0a, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00)  // " 0x22 034
+FONT_GLYPH (0x0a, 0x0a, 0x1f, 0x0a, 0x1f, 0x0a, 0x0a, 0x00)  // # 0x23 035
+FONT_GLYPH (0x04, 0x1e, 0x05, 0x0e, 0x14, 0x0f, 0x04, 0x00)  // $ 0x24 036
+FONT_GLYPH (0x03, 0x13, 0x08, 0x04, 0x02, 0x19, 0x18, 0x00)  // % 0x25 037
+FONT_GLYPH (0x02, 0x05, 0x05, 0x02, 0x15, 0x09, 0x16, 0x00)  // & 0x26 038
+FONT_GLYPH (0x0c, 0x0c, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00)  // ' 0x27 039
+FONT_GLYPH (0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08, 0x00)  // ( 0x28 040
+FONT_GLYPH (0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02, 0x00)  // ) 0x29 041
+FONT_GLYPH (0x04, 0x15, 0x0e, 0x1f, 0x0e, 0x15, 0x04, 0x00)  // * 0x2a 042
+FONT_GLYPH (0x00, 0x04, 0x04, 0x1f, 0x04, 0x04, 0x00, 0x00)  // + 0x2b 043
+FONT_GLYPH (0x00, 0x00, 0x00, 0x00, 0x0c, 0x0c, 0x04, 0x02)  // , 0x2c 044
+FONT_GLYPH (0x00, 0x00, 0x00, 0x1f, 0x00, 0x00, 0x00, 0x00)  // - 0x2d 045
+FONT_GLYPH (0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x0c, 0x00)  // . 0x2e 046
+FONT_GLYPH (0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00)  // / 0x2f 047
+FONT_GLYPH (0x0e, 0x11, 0x19, 0x15, 0x13, 0x11, 0x0e, 0x00)  // 0 0x30 048
+FONT_GLYPH (0x04, 0x06, 0x04, 0x04, 0x04, 0x04, 0x0e, 0x00)  // 1 0x31 049
+FONT_GLYPH (0x0e, 0x11, 0x10, 0x0e, 0x01, 0x01, 0x1f, 0x00)  // 2 0x32 050
+FONT_GLYPH (0x1f, 0x10, 0x08, 0x0c, 0x10, 0x11, 0x0e, 0x00)  // 3 0x33 051
+FONT_GLYPH (0x08, 0x0c, 0x0a, 0x09, 0x1f, 0x08, 0x08, 0x00)  // 4 0x34 052
+FONT_GLYPH (0x1f, 0x01, 0x0f, 0x10, 0x10, 0x11, 0x0e, 0x00)  // 5 0x35 053
+FONT_GLYPH (0x1c, 0x02, 0x01, 0x0f, 0x11, 0x11, 0x0e, 0x00)  // 6 0x36 054
+FONT_GLYPH (0x1f, 0x10, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00)  // 7 0x37 055
+FONT_GLYPH (0x0e, 0x11, 0x11, 0x0e, 0x11, 0x11, 0x0e, 0x00)  // 8 0x38 056
+FONT_GLYPH (0x0e, 0x11, 0x11, 0x1e, 0x10, 0x08, 0x07, 0x00)  // 9 0x39 057
+FONT_GLYPH (0x00, 0x00, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00)  // : 0x3a 058
+FONT_GLYPH (0x00, 0x00, 0x04, 0x00, 0x04, 0x04, 0x02, 0x00)  // ; 0x3b 059
+FONT_GLYPH (0x10, 0x08, 0x04, 0x02, 0x04, 0x08, 0x10, 0x00)  // < 0x3c 060
+FONT_GLYPH (0x00, 0x00, 0x1f, 0x00, 0x1f, 0x00, 0x00, 0x00)  // = 0x3d 061
+FONT_GLYPH (0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02, 0x00)  // > 0x3e 062
+FONT_GLYPH (0x0e, 0x11, 0x10, 0x0c, 0x04, 0x00, 0x04, 0x00)  // ? 0x3f 063
+FONT_GLYPH (0x0e, 0x11, 0x15, 0x1d, 0x0d, 0x01, 0x1e, 0x00)  // @ 0x40 064
+FONT_GLYPH (0x04, 0x0a, 0x11, 0x11, 0x1f, 0x11, 0x11, 0x00)  // A 0x41 065
+FONT_GLYPH (0x0f, 0x11, 0x11, 0x0f, 0x11, 0x11, 0x0f, 0x00)  // B 0x42 066
+FONT_GLYPH (0x0e, 0x11, 0x01, 0x01, 0x01, 0x11, 0x0e, 0x00)  // C 0x43 067
+FONT_GLYPH (0x0f, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0f, 0x00)  // D 0x44 068
+FONT_GLYPH (0x1f, 0x01, 0x01, 0x0f, 0x01, 0x01, 0x1f, 0x00)  // E 0x45 069
+FONT_GLYPH (0x1f, 0x01, 0x01, 0x0f, 0x01, 0x01, 0x01, 0x00)  // F 0x46 070
+FONT_GLYPH (0x1e, 0x11, 0x01, 0x01, 0x19, 0x11, 0x1e, 0x00)  // G 0x47 071
+FONT_GLYPH (0x11, 0x11, 0x11, 0x1f, 0x11, 0x11, 0x11, 0x00)  // H 0x48 072
+FONT_GLYPH (0x0e, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0e, 0x00)  // I 0x49 073
+FONT_GLYPH (0x1c, 0x08, 0x08, 0x08, 0x08, 0x09, 0x06, 0x00)  // J 0x4a 074
+FONT_GLYPH (0x11, 0x09, 0x05, 0x03, 0x05, 0x09, 0x11, 0x00)  // K 0x4b 075
+FONT_GLYPH (0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x1f, 0x00)  // L 0x4c 076
+FONT_GLYPH (0x11, 0x1b, 0x15, 0x15, 0x15, 0x11, 0x11, 0x00)  // M 0x4d 077
+FONT_GLYPH (0x11, 0x11, 0x13, 0x15, 0x19, 0x11, 0x11, 0x00)  // N 0x4e 078
+FONT_GLYPH (0x0e, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e, 0x00)  // O 0x4f 079
+FONT_GLYPH (0x0f, 0x11, 0x11, 0x0f, 0x01, 0x01, 0x01, 0x00)  // P 0x50 080
+FONT_GLYPH (0x0e, 0x11, 0x11, 0x11, 0x15, 0x09, 0x16, 0x00)  // Q 0x51 081
+FONT_GLYPH (0x0f, 0x11, 0x11, 0x0f, 0x05, 0x09, 0x11, 0x00)  // R 0x52 082
+FONT_GLYPH (0x0e, 0x11, 0x01, 0x0e, 0x10, 0x11, 0x0e, 0x00)  // S 0x53 083
+FONT_GLYPH (0x1f, 0x15, 0x04, 0x04, 0x04, 0x04, 0x04, 0x00)  // T 0x54 084
+FONT_GLYPH (0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e, 0x00)  // U 0x55 085
+FONT_GLYPH (0x11, 0x11, 0x11, 0x11, 0x11, 0x0a, 0x04, 0x00)  // V 0x56 086
+FONT_GLYPH (0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0a, 0x00)  // W 0x57 087
+FONT_GLYPH (0x11, 0x11, 0x0a, 0x04, 0x0a, 0x11, 0x11, 0x00)  // X 0x58 088
+FONT_GLYPH (0x11, 0x11, 0x0a, 0x04, 0x04, 0x04, 0x04, 0x00)  // Y 0x59 089
+FONT_GLYPH (0x1f, 0x10, 0x08, 0x0e, 0x02, 0x01, 0x1f, 0x00)  // Z 0x5a 090
+FONT_GLYPH (0x1e, 0x02, 0x02, 0x02, 0x02, 0x02, 0x1e, 0x00)  // [ 0x5b 091
+FONT_GLYPH (0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00, 0x00)  // \ 0x5c 092
+FONT_GLYPH (0x1e, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1e, 0x00)  // ] 0x5d 093
+FONT_GLYPH (0x04, 0x0a, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00)  // ^ 0x5e 094
+FONT_GLYPH (0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x00)  // _ 0x5f 095
+FONT_GLYPH (0x06, 0x06, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00)  // ` 0x60 096
+FONT_GLYPH (0x00, 0x00, 0x06, 0x08, 0x0e, 0x09, 0x1e, 0x00)  // a 0x61 097
+FONT_GLYPH (0x01, 0x01, 0x0d, 0x13, 0x11, 0x13, 0x0d, 0x00)  // b 0x62 098
+FONT_GLYPH (0x00, 0x00, 0x0e, 0x11, 0x01, 0x11, 0x0e, 0x00)  // c 0x63 099
+FONT_GLYPH (0x10, 0x10, 0x16, 0x19, 0x11, 0x19, 0x16, 0x00)  // d 0x64 100
+FONT_GLYPH (0x00, 0x00, 0x0e, 0x11, 0x1f, 0x01, 0x0e, 0x00)  // e 0x65 101
+FONT_GLYPH (0x08, 0x14, 0x04, 0x0e, 0x04, 0x04, 0x04, 0x00)  // f 0x66 102
+FONT_GLYPH (0x00, 0x00, 0x0e, 0x19, 0x19, 0x16, 0x10, 0x0e)  // g 0x67 103
+FONT_GLYPH (0x01, 0x01, 0x0d, 0x13, 0x11, 0x11, 0x11, 0x00)  // h 0x68 104
+FONT_GLYPH (0x04, 0x00, 0x06, 0x04, 0x04, 0x04, 0x0e, 0x00)  // i 0x69 105
+FONT_GLYPH (0x08, 0x00, 0x08, 0x08, 0x08, 0x09, 0x06, 0x00)  // j 0x6a 106
+FONT_GLYPH (0x01, 0x01, 0x09, 0x05, 0x03, 0x05, 0x09, 0x00)  // k 0x6b 107
+FONT_GLYPH (0x06, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0e, 0x00)  // l 0x6c 108
+FONT_GLYPH (0x00, 0x00, 0x0b, 0x15, 0x15, 0x15, 0x15, 0x00)  // m 0x6d 109
+FONT_GLYPH (0x00, 0x00, 0x0d, 0x13, 0x11, 0x11, 0x11, 0x00)  // n 0x6e 110
+FONT_GLYPH (0x00, 0x00, 0x0e, 0x11, 0x11, 0x11, 0x0e, 0x00)  // o 0x6f 111
+FONT_GLYPH (0x00, 0x00, 0x0d, 0x13, 0x13, 0x0d, 0x01, 0x01)  // p 0x70 112
+FONT_GLYPH (0x00, 0x00, 0x16, 0x19, 0x19, 0x16, 0x10, 0x10)  // q 0x71 113
+FONT_GLYPH (0x00, 0x00, 0x0d, 0x13, 0x01, 0x01, 0x01, 0x00)  // r 0x72 114
+FONT_GLYPH (0x00, 0x00, 0x1e, 0x01, 0x0e, 0x10, 0x0f, 0x00)  // s 0x73 115
+FONT_GLYPH (0x04, 0x04, 0x1f, 0x04, 0x04, 0x14, 0x08, 0x00)  // t 0x74 116
+FONT_GLYPH (0x00, 0x00, 0x11, 0x11, 0x11, 0x19, 0x16, 0x00)  // u 0x75 117
+FONT_GLYPH (0x00, 0x00, 0x11, 0x11, 0x11, 0x0a, 0x04, 0x00)  // v 0x76 118
+FONT_GLYPH (0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0a, 0x00)  // w 0x77 119
+FONT_GLYPH (0x00, 0x00, 0x11, 0x0a, 0x04, 0x0a, 0x11, 0x00)  // x 0x78 120
+FONT_GLYPH (0x00, 0x00, 0x11, 0x11, 0x1e, 0x10, 0x11, 0x0e)  // y 0x79 121
+FONT_GLYPH (0x00, 0x00, 0x1f, 0x08, 0x04, 0x02, 0x1f, 0x00)  // z 0x7a 122
+FONT_GLYPH (0x08, 0x04, 0x04, 0x02, 0x04, 0x04, 0x08, 0x00)  // { 0x7b 123
+FONT_GLYPH (0x04, 0x04, 0x04, 0x00, 0x04, 0x04, 0x04, 0x00)  // | 0x7c 124
+FONT_GLYPH (0x02, 0x04, 0x04, 0x08, 0x04, 0x04, 0x02, 0x00)  // } 0x7d 125
+FONT_GLYPH (0x02, 0x15, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00)  // ~ 0x7e 126
+FONT_GLYPH (0x04, 0x0e, 0x1b, 0x11, 0x11, 0x1f, 0x00, 0x00)  //  0x7f 127
+FONT_GLYPH (0x0e, 0x11, 0x01, 0x01, 0x11, 0x0e, 0x08, 0x06)  //  0x80 128
+FONT_GLYPH (0x00, 0x11, 0x00, 0x11, 0x11, 0x19, 0x16, 0x00)  //  0x81 129
+FONT_GLYPH (0x18, 0x00, 0x0e, 0x11, 0x1f, 0x01, 0x1e, 0x00)  //  0x82 130
+FONT_GLYPH (0x1f, 0x00, 0x06, 0x08, 0x0e, 0x09, 0x1e, 0x00)  //  0x83 131
+FONT_GLYPH (0x11, 0x00, 0x06, 0x08, 0x0e, 0x09, 0x1e, 0x00)  //  0x84 132
+FONT_GLYPH (0x03, 0x00, 0x06, 0x08, 0x0e, 0x09, 0x1e, 0x00)  //  0x85 133
+FONT_GLYPH (0x0c, 0x00, 0x06, 0x08, 0x0e, 0x09, 0x1e, 0x00)  //  0x86 134
+FONT_GLYPH (0x00, 0x1e, 0x03, 0x03, 0x1e, 0x08, 0x0c, 0x00)  //  0x87 135
+FONT_GLYPH (0x1f, 0x00, 0x0e, 0x11, 0x1f, 0x01, 0x1e, 0x00)  //  0x88 136
+FONT_GLYPH (0x11, 0x00, 0x0e, 0x11, 0x1f, 0x01, 0x1e, 0x00)  //  0x89 137
+FONT_GLYPH (0x03, 0x00, 0x0e, 0x11, 0x1f, 0x01, 0x1e, 0x00)  //  0x8a 138
+FONT_GLYPH (0x14, 0x00, 0x0c, 0x08, 0x08, 0x08, 0x1c, 0x00)  //  0x8b 139
+FONT_GLYPH (0x0c, 0x12, 0x0c, 0x08, 0x08, 0x08, 0x1c, 0x00)  //  0x8c 140
+FONT_GLYPH (0x06, 0x00, 0x0c, 0x08, 0x08, 0x08, 0x1c, 0x00)  //  0x8d 141
+FONT_GLYPH (0x0a, 0x00, 0x04, 0x0a, 0x11, 0x1f, 0x11, 0x11)  //  0x8e 142
+FONT_GLYPH (0x04, 0x00, 0x04, 0x0a, 0x11, 0x1f, 0x11, 0x11)  //  0x8f 143
+FONT_GLYPH (0x0c, 0x00, 0x0f, 0x01, 0x07, 0x01, 0x0f, 0x00)  //  0x90 144
+FONT_GLYPH (0x00, 0x00, 0x1e, 0x08, 0x1e, 0x09, 0x1e, 0x00)  //  0x91 145
+FONT_GLYPH (0x1c, 0x0a, 0x09, 0x1f, 0x09, 0x09, 0x19, 0x00)  //  0x92 146
+FONT_GLYPH (0x0e, 0x11, 0x00, 0x0e, 0x11, 0x11, 0x0e, 0x00)  //  0x93 147
+FONT_GLYPH (0x00, 0x11, 0x00, 0x0e, 0x11, 0x11, 0x0e, 0x00)  //  0x94 148
+FONT_GLYPH (0x00, 0x03, 0x00, 0x0e, 0x11, 0x11, 0x0e, 0x00)  //  0x95 149
+FONT_GLYPH (0x0e, 0x11, 0x00, 0x11, 0x11, 0x19, 0x16, 0x00)  //  0x96 150
+FONT_GLYPH (0x00, 0x03, 0x00, 0x11, 0x11, 0x19, 0x16, 0x00)  //  0x97 151
+FONT_GLYPH (0x12, 0x00, 0x12, 0x12, 0x12, 0x1c, 0x10, 0x0e)  //  0x98 152
+FONT_GLYPH (0x11, 0x00, 0x0e, 0x11, 0x11, 0x11, 0x0e, 0x00)  //  0x99 153
+FONT_GLYPH (0x11, 0x00, 0x11, 0x11, 0x11, 0x11, 0x0e, 0x00)  //  0x9a 154
+FONT_GLYPH (0x04, 0x04, 0x1f, 0x05, 0x05, 0x1f, 0x04, 0x04)  //  0x9b 155
+FONT_GLYPH (0x0c, 0x1a, 0x12, 0x07, 0x02, 0x12, 0x1f, 0x00)  //  0x9c 156
+FONT_GLYPH (0x1b, 0x1b, 0x0e, 0x1f, 0x04, 0x1f, 0x04, 0x04)  //  0x9d 157
+FONT_GLYPH (0x07, 0x09, 0x09, 0x07, 0x09, 0x1d, 0x09, 0x09)  //  0x9e 158
+FONT_GLYPH (0x18, 0x14, 0x04, 0x0e, 0x04, 0x04, 0x05, 0x03)  //  0x9f 159
+FONT_GLYPH (0x18, 0x00, 0x06, 0x08, 0x0e, 0x09, 0x1e, 0x00)  //  0xa0 160
+FONT_GLYPH (0x18, 0x00, 0x0c, 0x08, 0x08, 0x08, 0x1c, 0x00)  //  0xa1 161
+FONT_GLYPH (0x00, 0x18, 0x00, 0x0e, 0x11, 0x11, 0x0e, 0x00)  //  0xa2 162
+FONT_GLYPH (0x00, 0x18, 0x00, 0x11, 0x11, 0x19, 0x16, 0x00)  //  0xa3 163
+FONT_GLYPH (0x00, 0x1e, 0x00, 0x0e, 0x12, 0x12, 0x12, 0x00)  //  0xa4 164
+FONT_GLYPH (0x1f, 0x00, 0x13, 0x17, 0x1d, 0x19, 0x11, 0x00)  //  0xa5 165
+FONT_GLYPH (0x0e, 0x09, 0x09, 0x1e, 0x00, 0x1f, 0x00, 0x00)  //  0xa6 166
+FONT_GLYPH (0x0e, 0x11, 0x11, 0x0e, 0x00, 0x1f, 0x00, 0x00)  //  0xa7 167
+FONT_GLYPH (0x04, 0x00, 0x04, 0x06, 0x01, 0x11, 0x0e, 0x00)  //  0xa8 168
+FONT_GLYPH (0x00, 0x00, 0x00, 0x1f, 0x01, 0x01, 0x00, 0x00)  //  0xa9 169
+FONT_GLYPH (0x00, 0x00, 0x00, 0x1f, 0x10, 0x10, 0x00, 0x00)  //  0xaa 170
+FONT_GLYPH (0x01, 0x11, 0x09, 0x1d, 0x12, 0x19, 0x04, 0x1c)  //  0xab 171
+FONT_GLYPH (0x01, 0x11, 0x09, 0x15, 0x1a, 0x1d, 0x10, 0x10)  //  0xac 172
+FONT_GLYPH (0x04, 0x04, 0x00, 0x04, 0x04, 0x04, 0x04, 0x00)  //  0xad 173
+FONT_GLYPH (0x00, 0x14, 0x0a, 0x05, 0x0a, 0x14, 0x00, 0x00)  //  0xae 174
+FONT_GLYPH (0x00, 0x05, 0x0a, 0x14, 0x0a, 0x05, 0x00, 0x00)  //  0xaf 175
+FONT_GLYPH (0x04, 0x11, 0x04, 0x11, 0x04, 0x11, 0x04, 0x11)  //  0xb0 176
+FONT_GLYPH (0x0a, 0x15, 0x0a, 0x15, 0x0a, 0x15, 0x0a, 0x15)  //  0xb1 177
+FONT_GLYPH (0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08)  //  0xb2 178
+FONT_GLYPH (0x08, 0x08, 0x08, 0x08, 0x0f, 0x08, 0x08, 0x08)  //  0xb3 179
+FONT_GLYPH (0x08, 0x08, 0x0f, 0x08, 0x0f, 0x08, 0x08, 0x08)  //  0xb4 180
+FONT_GLYPH (0x14, 0x14, 0x14, 0x14, 0x17, 0x14, 0x14, 0x14)  //  0xb5 181
+FONT_GLYPH (0x00, 0x00, 0x00, 0x00, 0x1f, 0x14, 0x14, 0x14)  //  0xb6 182
+FONT_GLYPH (0x00, 0x00, 0x0f, 0x08, 0x0f, 0x08, 0x08, 0x08)  //  0xb7 183
+FONT_GLYPH (0x14, 0x14, 0x17, 0x10, 0x17, 0x14, 0x14, 0x14)  //  0xb8 184
+FONT_GLYPH (0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14)  //  0xb9 185
+FONT_GLYPH (0x00, 0x00, 0x1f, 0x10, 0x17, 0x14, 0x14, 0x14)  //  0xba 186
+FONT_GLYPH (0x14, 0x14, 0x17, 0x10, 0x1f, 0x00, 0x00, 0x00)  //  0xbb 187
+FONT_GLYPH (0x14, 0x14, 0x14, 0x14, 0x1f, 0x00, 0x00, 0x00)  //  0xbc 188
+FONT_GLYPH (0x08, 0x08, 0x0f, 0x08, 0x0f, 0x00, 0x00, 0x00)  //  0xbd 189
+FONT_GLYPH (0x00, 0x00, 0x00, 0x00, 0x0f, 0x08, 0x08, 0x08)  //  0xbe 190
+FONT_GLYPH (0x08, 0x08, 0x08, 0x08, 0x38, 0x00, 0x00, 0x00)  //  0xbf 191
+FONT_GLYPH (0x08, 0x08, 0x08, 0x08, 0x1f, 0x00, 0x00, 0x00)  //  0xc0 192
+FONT_GLYPH (0x00, 0x00, 0x00, 0x00, 0x1f, 0x08, 0x08, 0x08)  //  0xc1 193
+FONT_GLYPH (0x08, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x08)  //  0xc2 194
+FONT_GLYPH (0x00, 0x00, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x00)  //  0xc3 195
+FONT_GLYPH (0x08, 0x08, 0x08, 0x08, 0x1f, 0x08, 0x08, 0x08)  //  0xc4 196
+FONT_GLYPH (0x08, 0x08, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08)  //  0xc5 197
+FONT_GLYPH (0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14)  //  0xc6 198
+FONT_GLYPH (0x14, 0x14, 0x14, 0x04, 0x1c, 0x00, 0x00, 0x00)  //  0xc7 199
+FONT_GLYPH (0x00, 0x00, 0x1c, 0x04, 0x14, 0x14, 0x14, 0x14)  //  0xc8 200
+FONT_GLYPH (0x14, 0x14, 0x17, 0x00, 0x1f, 0x00, 0x00, 0x00)  //  0xc9 201
+FONT_GLYPH (0x00, 0x00, 0x1f, 0x00, 0x17, 0x14, 0x14, 0x14)  //  0xca 202
+FONT_GLYPH (0x14, 0x14, 0x14, 0x04, 0x14, 0x14, 0x14, 0x14)  //  0xcb 203
+FONT_GLYPH (0x00, 0x00, 0x1f, 0x00, 0x1f, 0x00, 0x00, 0x00)  //  0xcc 204
+FONT_GLYPH (0x14, 0x14, 0x17, 0x00, 0x17, 0x14, 0x14, 0x14)  //  0xcd 205
+FONT_GLYPH (0x08, 0x08, 0x1f, 0x00, 0x1f, 0x00, 0x00, 0x00)  //  0xce 206
+FONT_GLYPH (0x14, 0x14, 0x14, 0x14, 0x1f, 0x00, 0x00, 0x00)  //  0xcf 207
+FONT_GLYPH (0x00, 0x00, 0x1f, 0x00, 0x1f, 0x08, 0x08, 0x08)  //  0xd0 208
+FONT_GLYPH (0x00, 0x00, 0x00, 0x00, 0x1f, 0x14, 0x14, 0x14)  //  0xd1 209
+FONT_GLYPH (0x14, 0x14, 0x14, 0x14, 0x1c, 0x00, 0x00, 0x00)  //  0xd2 210
+FONT_GLYPH (0x08, 0x08, 0x18, 0x08, 0x18, 0x00, 0x00, 0x00)  //  0xd3 211
+FONT_GLYPH (0x00, 0x00, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08)  //  0xd4 212
+FONT_GLYPH (0x00, 0x00, 0x00, 0x00, 0x1c, 0x14, 0x14, 0x14)  //  0xd5 213
+FONT_GLYPH (0x14, 0x14, 0x14, 0x14, 0x1f, 0x14, 0x14, 0x14)  //  0xd6 214
+FONT_GLYPH (0x08, 0x08, 0x1f, 0x08, 0x1f, 0x08, 0x08, 0x08)  //  0xd7 215
+FONT_GLYPH (0x08, 0x08, 0x08, 0x08, 0x0f, 0x00, 0x00, 0x00)  //  0xd8 216
+FONT_GLYPH (0x00, 0x00, 0x00, 0x00, 0x38, 0x08, 0x08, 0x08)  //  0xd9 217
+FONT_GLYPH (0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f)  //  0xda 218
+FONT_GLYPH (0x00, 0x00, 0x00, 0x00, 0x1f, 0x1f, 0x1f, 0x1f)  //  0xdb 219
+FONT_GLYPH (0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07)  //  0xdc 220
+FONT_GLYPH (0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18)  //  0xdd 221
+FONT_GLYPH (0x1f, 0x1f, 0x1f, 0x1f, 0x00, 0x00, 0x00, 0x00)  //  0xde 222
+FONT_GLYPH (0x00, 0x00, 0x16, 0x09, 0x09, 0x09, 0x16, 0x00)  //  0xdf 223
+FONT_GLYPH (0x00, 0x0e, 0x19, 0x0f, 0x19, 0x0f, 0x01, 0x00)  //  0xe0 224
+FONT_GLYPH (0x00, 0x1f, 0x19, 0x01, 0x01, 0x01, 0x01, 0x00)  //  0xe1 225
+FONT_GLYPH (0x00, 0x1f, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x00)  //  0xe2 226
+FONT_GLYPH (0x1f, 0x11, 0x02, 0x04, 0x02, 0x11, 0x1f, 0x00)  //  0xe3 227
+FONT_GLYPH (0x00, 0x00, 0x1e, 0x09, 0x09, 0x09, 0x06, 0x00)  //  0xe4 228
+FONT_GLYPH (0x00, 0x0a, 0x0a, 0x0a, 0x0a, 0x16, 0x03, 0x00)  //  0xe5 229
+FONT_GLYPH (0x00, 0x1f, 0x05, 0x04, 0x04, 0x04, 0x04, 0x00)  //  0xe6 230
+FONT_GLYPH (0x1f, 0x04, 0x0e, 0x11, 0x11, 0x0e, 0x04, 0x1f)  //  0xe7 231
+FONT_GLYPH (0x04, 0x0a, 0x11, 0x1f, 0x11, 0x0a, 0x04, 0x00)  //  0xe8 232
+FONT_GLYPH (0x04, 0x0a, 0x11, 0x11, 0x0a, 0x0a, 0x1b, 0x00)  //  0xe9 233
+FONT_GLYPH (0x0c, 0x02, 0x0c, 0x0e, 0x11, 0x11, 0x0e, 0x00)  //  0xea 234
+FONT_GLYPH (0x00, 0x00, 0x00, 0x0e, 0x15, 0x15, 0x0e, 0x00)  //  0xeb 235
+FONT_GLYPH (0x10, 0x0e, 0x19, 0x15, 0x15, 0x13, 0x0e, 0x01)  //  0xec 236
+FONT_GLYPH (0x0e, 0x01, 0x01, 0x0f, 0x01, 0x01, 0x0e, 0x00)  //  0xed 237
+FONT_GLYPH (0x0e, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x00)  //  0xee 238
+FONT_GLYPH (0x00, 0x1f, 0x00, 0x1f, 0x00, 0x1f, 0x00, 0x00)  //  0xef 239
+FONT_GLYPH (0x04, 0x04, 0x1f, 0x04, 0x04, 0x00, 0x1f, 0x00)  //  0xf0 240
+FONT_GLYPH (0x02, 0x04, 0x08, 0x04, 0x02, 0x00, 0x1f, 0x00)  //  0xf1 241
+FONT_GLYPH (0x08, 0x04, 0x02, 0x04, 0x08, 0x00, 0x1f, 0x00)  //  0xf2 242
+FONT_GLYPH (0x1c, 0x14, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04)  //  0xf3 243
+FONT_GLYPH (0x04, 0x04, 0x04, 0x04, 0x04, 0x05, 0x05, 0x07)  //  0xf4 244
+FONT_GLYPH (0x0c, 0x0c, 0x00, 0x1f, 0x00, 0x0c, 0x0c, 0x00)  //  0xf5 245
+FONT_GLYPH (0x00, 0x17, 0x1d, 0x00, 0x17, 0x1d, 0x00, 0x00)  //  0xf6 246
+FONT_GLYPH (0x0e, 0x1b, 0x1b, 0x0e, 0x00, 0x00, 0x00, 0x00)  //  0xf7 247
+FONT_GLYPH (0x00, 0x00, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00)  //  0xf8 248
+FONT_GLYPH (0x00, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00)  //  0xf9 249
+FONT_GLYPH (0x1c, 0x04, 0x04, 0x04, 0x05, 0x05, 0x06, 0x04)  //  0xfa 250
+FONT_GLYPH (0x0e, 0x12, 0x12, 0x12, 0x12, 0x00, 0x00, 0x00)  //  0xfb 251
+FONT_GLYPH (0x0e, 0x18, 0x0c, 0x06, 0x1e, 0x00, 0x00, 0x00)  //  0xfc 252
+FONT_GLYPH (0x00, 0x00, 0x1e, 0x1e, 0x1e, 0x1e, 0x00, 0x00)  //  0xfd 253
+FONT_GLYPH (0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00)  //  0xfe 254
+FONT_GLYPH (0x11, 0x19, 0x1b, 0x10, 0x03, 0x1b, 0x1b, 0x00)  //  0xff 255
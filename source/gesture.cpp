@@ -0,0 +1,146 @@
+/// @file gesture.cpp
+/// @brief Click, double-click, long-press and turn gestures from
+///        timestamped knob edges
+
+#include "gesture.hpp"
+
+CGesture::CGesture ()
+: m_doublems (300), m_longms (600), m_down (0), m_up (0), m_lost (0),
+  m_head (0), m_count (0), m_state (STATE_IDLE), m_second (false), 
+  m_done (false)
+{
+}
+
+void
+CGesture::configure (uint32_t doublems, uint32_t longms)
+{
+    m_doublems = doublems;
+    m_longms = longms;
+}
+
+void
+CGesture::emit (uint8_t kind, uint32_t stamp, int32_t delta)
+{
+    // consecutive turns of one kind add up, so fast spins cannot fill 
+    // the queue
+    if (m_count) {
+        gesture_t &last = m_queue[(m_head + m_count - 1) % GESTURE_QUEUE];
+        if ((kind == last.kind) && 
+            ((kind == GESTURE_TURN) || (kind == GESTURE_PRESSTURN))) {
+            last.delta += delta;
+            last.stamp = stamp;
+            return;
+        }
+    }
+    if (m_count == GESTURE_QUEUE) {
+        ++m_lost;
+        return;
+    }
+    gesture_t &g = m_queue[(m_head + m_count) % GESTURE_QUEUE];
+    g.stamp = stamp;
+    g.delta = delta;
+    g.kind = kind;
+    ++m_count;
+}
+
+void
+CGesture::settle ()
+{
+    // the press became a long press or a turn, so the short press 
+    // before it was a click of its own
+    if (m_second) emit (GESTURE_CLICK, m_up);
+    m_second = false;
+    m_done = true;
+}
+
+void
+CGesture::feed (const knob_event_t &e)
+{
+    if (m_state == STATE_PRESSED && !m_done && 
+        (e.stamp - m_down >= m_longms)) {
+        // expire() was late; the long press came first
+        settle ();
+        emit (GESTURE_LONG, m_down + m_longms);
+    }
+
+    switch (e.edge) {
+    case KNOB_PRESS:
+        if (m_state == STATE_PRESSED) return;
+        m_second = false;
+        if (m_state == STATE_RELEASED) {
+            if (e.stamp - m_up <= m_doublems)
+                m_second = true;
+            else
+                emit (GESTURE_CLICK, m_up + m_doublems);
+        }
+        m_state = STATE_PRESSED;
+        m_down = e.stamp;
+        m_done = false;
+        break;
+
+    case KNOB_RELEASE:
+        if (m_state != STATE_PRESSED) return;
+        m_state = STATE_IDLE;
+        if (m_done) return;
+        if (m_second) {
+            emit (GESTURE_DOUBLE, e.stamp);
+            m_second = false;
+        } else if (m_doublems == 0) {
+            emit (GESTURE_CLICK, e.stamp);
+        } else {
+            m_up = e.stamp;
+            m_state = STATE_RELEASED;
+        }
+        break;
+
+    case KNOB_TURN:
+        if (m_state == STATE_PRESSED) {
+            settle ();
+            emit (GESTURE_PRESSTURN, e.stamp, e.step);
+            break;
+        }
+        if (m_state == STATE_RELEASED) {
+            emit (GESTURE_CLICK, e.stamp);
+            m_state = STATE_IDLE;
+        }
+        emit (GESTURE_TURN, e.stamp, e.step);
+        break;
+    }
+}
+
+void
+CGesture::expire (uint32_t now)
+{
+    if (m_state == STATE_RELEASED && (now - m_up > m_doublems)) {
+        emit (GESTURE_CLICK, m_up + m_doublems);
+        m_state = STATE_IDLE;
+    } else if (m_state == STATE_PRESSED && !m_done && 
+               (now - m_down >= m_longms)) {
+        settle ();
+        emit (GESTURE_LONG, m_down + m_longms);
+    }
+}
+
+bool
+CGesture::deadline (uint32_t *at) const
+{
+    if (m_state == STATE_RELEASED) {
+        *at = m_up + m_doublems + 1;
+        return true;
+    }
+    if (m_state == STATE_PRESSED && !m_done) {
+        *at = m_down + m_longms;
+        return true;
+    }
+    return false;
+}
+
+bool
+CGesture::next (gesture_t *g)
+{
+    if (m_count == 0) return false;
+    *g = m_queue[m_head];
+    m_head = (m_head + 1) % GESTURE_QUEUE;
+    --m_count;
+    return true;
+}
@@ -0,0 +1,98 @@
+/// @file gesture.hpp
+/// @brief Click, double-click, long-press and turn gestures from
+///        timestamped knob edges
+
+#ifndef _GESTURE_HPP_
+#define _GESTURE_HPP_
+
+#include <stdint.h>
+#include "knob.hpp"
+
+#define GESTURE_QUEUE 8         ///< gestures buffered until next()
+
+/// @brief Kinds of recognized gestures
+enum gesture_kind_t {
+    GESTURE_CLICK = 0,          ///< short press, no second one followed
+    GESTURE_DOUBLE,             ///< two short presses in quick succession
+    GESTURE_LONG,               ///< press held for the long-press time
+    GESTURE_TURN,               ///< turn with the button up, fine steps
+    GESTURE_PRESSTURN           ///< turn with the button down, coarse steps
+};
+
+/// @brief A recognized gesture
+struct gesture_t {
+    uint32_t stamp;             ///< millis() of the edge completing it
+    int32_t  delta;             ///< detents of turns, summed while queued
+    uint8_t  kind;              ///< gesture_kind_t
+};
+
+/// @brief Class turning knob edges into gestures. feed() takes the edges
+///        in order, next() returns the completed gestures. A click is only
+///        complete once the double-click window has passed and a long
+///        press once it has been held long enough, so both complete from
+///        a timeout: call expire() when deadline() says so. A turn while
+///        pressed cancels the click or long press of that press.
+///
+///        while (knob->event (&e)) gestures.feed (e);
+///        if (gestures.deadline (&at) && (int32_t) (millis () - at) >= 0)
+///            gestures.expire (millis ());
+///        while (gestures.next (&g)) ...
+class CGesture {
+public:
+    /// @brief Default constructor, 300 ms double-click, 600 ms long press
+    CGesture ();
+
+    /// @brief Set the timing
+    /// @param doublems  Largest release to press time of a double-click,
+    ///                  0 reports every short press as a click at once
+    /// @param longms    Hold time of a long press; keep it well below the
+    ///                  hold-to-stop time of CSupervisor::begin()
+    void configure (uint32_t doublems, uint32_t longms);
+
+    /// @brief Take the next knob edge
+    void feed (const knob_event_t &e);
+
+    /// @brief Complete gestures waiting for a timeout
+    /// @param now  millis() now
+    void expire (uint32_t now);
+
+    /// @brief Get the time expire() is due, if a gesture waits for one
+    /// @param at  Pointer to receive the millis() expire() is due at
+    /// @return    true if a timeout is pending
+    bool deadline (uint32_t *at) const;
+
+    /// @brief Get the next completed gesture
+    /// @return true if one was returned
+    bool next (gesture_t *g);
+
+    /// @brief Get whether the button is down as seen by feed()
+    bool pressed () const { return m_state == STATE_PRESSED; }
+
+    /// @brief Get the number of gestures dropped because the queue was full
+    uint32_t lost () const { return m_lost; }
+
+protected:
+    enum state_t {
+        STATE_IDLE = 0,         ///< nothing pending
+        STATE_PRESSED,          ///< button down
+        STATE_RELEASED          ///< short press up, double-click window open
+    };
+
+    void emit (uint8_t kind, uint32_t stamp, int32_t delta = 0);
+    void settle ();
+
+protected:
+    uint32_t  m_doublems;       ///< double-click window
+    uint32_t  m_longms;         ///< long-press time
+    uint32_t  m_down;           ///< stamp of the last press
+    uint32_t  m_up;             ///< stamp of the last short release
+    uint32_t  m_lost;           ///< gestures dropped
+    gesture_t m_queue[GESTURE_QUEUE];  ///< completed gestures
+    uint8_t   m_head;           ///< next queue entry to return
+    uint8_t   m_count;          ///< queued gestures
+    uint8_t   m_state;          ///< state_t
+    bool      m_second;         ///< the press follows a short press
+    bool      m_done;           ///< the press already made its gesture
+};
+
+#endif // _GESTURE_HPP_
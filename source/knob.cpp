@@ -1,7 +1,9 @@
 /// @file knob.cpp
 /// @brief Quadrature decoding of a rotary encoder with push button
 
+#include "cycles.hpp"
 #include "knob.hpp"
+#include "sched.hpp"
 
 CKnob CKnob::s_singleton;
 
@@ -11,11 +13,30 @@ CKnob::knob_interrupt ()
     CKnob::get ()->interrupt ();
 }
 
+void
+CKnob::record (uint8_t edge, int8_t step)
+{
+    ++m_edges;
+    if (m_evhead - m_evtail >= KNOB_EVENTS) {
+        ++m_lost;
+        return;
+    }
+    knob_event_t &e = m_events[m_evhead % KNOB_EVENTS];
+    e.stamp = millis ();
+    e.edge = edge;
+    e.step = step;
+    __sync_synchronize ();
+    ++m_evhead;
+    if (m_task >= 0) CScheduler::get ()->signal (m_task);
+}
+
 void
 CKnob::interrupt ()
 {
+    if (m_pending == 0) m_edge = cycles ();
     if (((pioa->PIO_PDSR & maska) != 0) != m_ahigh) {
         m_ahigh = !m_ahigh;
+        if (m_ahigh && !m_bhigh) record (KNOB_TURN, -1);
         // adjust counter - 1 if A leads B
         if (!(m_pending & BIT_LEFT) && (m_ahigh && !m_bhigh)) {
             m_rel -= 1;
@@ -24,6 +45,7 @@ CKnob::interrupt ()
     }
     if (((piob->PIO_PDSR & maskb) != 0) != m_bhigh) {
         m_bhigh = !m_bhigh; 
+        if (m_bhigh && !m_ahigh) record (KNOB_TURN, 1);
         // adjust counter + 1 if B leads A
         if (!(m_pending & BIT_RIGHT) && (m_bhigh && !m_ahigh)) {
             m_rel += 1;
@@ -32,6 +54,7 @@ CKnob::interrupt ()
     }
     if (((piop->PIO_PDSR & maskp) != 0) == m_down) { // == sic! down is inverted
         m_down = !m_down;
+        record (m_down ? KNOB_PRESS : KNOB_RELEASE, 0);
         if (m_down)
             m_pending |= BIT_PUSH;
     }
@@ -69,6 +92,7 @@ CKnob::configure (uint8_t pinqa, uint8_t pinqb, uint8_t pinpush)
     piop->PIO_SCDR = 20;    // SLOWCLK/20 = 1.6 kHz
 
     m_pending = 0;
+    cycles_begin ();
 }
 
 uint8_t 
@@ -81,12 +105,27 @@ CKnob::query (uint8_t *out_pressed, int32_t *out_relative)
         *out_relative = m_rel;
     m_rel = 0;
     uint8_t pending = m_pending;
+    m_eventstamp = m_edge;
+    m_querystamp = cycles ();
     m_pending = 0;
     return pending;
 }
 
+bool
+CKnob::event (knob_event_t *e)
+{
+    if (m_evtail == m_evhead) return false;
+    __sync_synchronize ();
+    *e = m_events[m_evtail % KNOB_EVENTS];
+    __sync_synchronize ();
+    ++m_evtail;
+    return true;
+}
+
 CKnob::CKnob ()
 : pioa (0), piob (0), piop (0), maska (0), maskb (0), maskp (0),
-  m_ahigh (0), m_bhigh (0), m_rel (0), m_down (0), m_pending (0)
+  m_ahigh (0), m_bhigh (0), m_rel (0), m_down (0), m_pending (0),
+  m_edge (0), m_eventstamp (0), m_querystamp (0), m_evhead (0), 
+  m_evtail (0), m_lost (0), m_edges (0), m_task (-1)
 {
 }
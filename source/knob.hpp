@@ -4,6 +4,24 @@
 #ifndef _KNOB_HPP_
 #define _KNOB_HPP_
 
+#include "Arduino.h"
+
+#define KNOB_EVENTS 16          ///< edges buffered until event(), power of 2
+
+/// @brief Kinds of knob edges recorded by the knob interrupt
+enum knob_edge_t {
+    KNOB_PRESS = 0,             ///< push button went down
+    KNOB_RELEASE,               ///< push button went up
+    KNOB_TURN                   ///< one detent, see knob_event_t::step
+};
+
+/// @brief A timestamped knob edge
+struct knob_event_t {
+    uint32_t stamp;             ///< millis() of the edge
+    uint8_t  edge;              ///< knob_edge_t
+    int8_t   step;              ///< +1 right, -1 left for KNOB_TURN
+};
+
 /// @brief Class supporting a rotary encoder with push button
 class CKnob {
 public:
@@ -30,12 +48,46 @@ public:
     /// @return         Bit mask composed from pending BIT_xxx values
     uint8_t query (uint8_t *pressed, int32_t *relative);    
 
+    /// @brief Get whether the push button is down now
+    bool down () const { return m_down; }
+
+    /// @brief Peek at the pending BIT_xxx values without clearing them
+    uint8_t pending () const { return m_pending; }
+
+    /// @brief Get the next timestamped edge recorded by the interrupt,
+    ///        for CGesture. Every detent and both button edges are kept,
+    ///        independent of query().
+    /// @return true if one was returned
+    bool event (knob_event_t *e);
+
+    /// @brief Get the number of edges dropped because event() fell behind
+    uint32_t lostEvents () const { return m_lost; }
+
+    /// @brief Get the number of edges seen, wrapping. Neither query() nor
+    ///        event() clears it, so any reader can detect activity by 
+    ///        comparing it with the value it saw before.
+    uint32_t edges () const { return m_edges; }
+
+    /// @brief Release a CScheduler event task on every recorded edge, so 
+    ///        the main loop can sleep until there is input to handle
+    /// @param task  Task id, or -1 for none
+    void notify (int8_t task) { m_task = task; }
+
+    /// @brief Get the cycle counter time of the first edge of the events
+    ///        returned by the last query(), @see cycles()
+    uint32_t eventStamp () const { return m_eventstamp; }
+
+    /// @brief Get the cycle counter time of the last query() returning 
+    ///        events
+    uint32_t queryStamp () const { return m_querystamp; }
+
 protected:
     /// @brief Default constructor
     CKnob ();
 
     static void knob_interrupt ();
     void interrupt ();
+    void record (uint8_t edge, int8_t step);
 
 protected:
     static CKnob s_singleton;    ///< The singleton knob object
@@ -52,6 +104,15 @@ protected:
     volatile int32_t m_rel;      ///< relative knob position since last query()
     volatile uint8_t m_down;     ///< whether knob is down or not
     volatile uint8_t m_pending;  ///< whether a knob reading has changed
+    volatile uint32_t m_edge;    ///< cycles() at the first pending edge
+    uint32_t m_eventstamp;       ///< m_edge of the events last returned
+    uint32_t m_querystamp;       ///< cycles() at the last query() with events
+    knob_event_t m_events[KNOB_EVENTS];  ///< edges written by the interrupt
+    volatile uint32_t m_evhead;  ///< edges written, by the interrupt
+    volatile uint32_t m_evtail;  ///< edges read, by event()
+    volatile uint32_t m_lost;    ///< edges dropped on a full buffer
+    volatile uint32_t m_edges;   ///< edges seen, @see edges()
+    int8_t m_task;               ///< task released on edges, or -1
 };
 
 #endif // _KNOB_HPP_
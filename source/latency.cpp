@@ -0,0 +1,128 @@
+/// @file latency.cpp
+/// @brief Latency histograms and knob-to-glass/output traces
+
+#include <stdio.h>
+#include <string.h>
+#include "latency.hpp"
+
+void
+CLatencyStats::reset ()
+{
+    memset (m_hist, 0, sizeof (m_hist));
+    m_count = 0;
+    m_max = 0;
+}
+
+uint8_t
+CLatencyStats::bucket (uint32_t us)
+{
+    // LAT_SUB linear buckets below LAT_SUB us, then LAT_SUB per octave
+    if (us < LAT_SUB) return us;
+    uint8_t e = 31 - __builtin_clz (us);
+    uint32_t b = LAT_SUB * (e - 2) + ((us >> (e - 3)) & (LAT_SUB - 1));
+    return b < LAT_BUCKETS ? b : LAT_BUCKETS - 1;
+}
+
+uint32_t
+CLatencyStats::upper (uint8_t b)
+{
+    if (b < LAT_SUB) return b;
+    uint8_t e = b / LAT_SUB + 2;
+    return ((LAT_SUB + b % LAT_SUB + 1) << (e - 3)) - 1;
+}
+
+void
+CLatencyStats::add (uint32_t us)
+{
+    uint8_t b = bucket (us);
+    if (m_hist[b] < 0xFFFF) ++m_hist[b];
+    ++m_count;
+    if (us > m_max) m_max = us;
+}
+
+uint32_t
+CLatencyStats::percentile (uint8_t pct) const
+{
+    uint32_t n = 0, total = 0;
+    for (uint8_t b = 0; b < LAT_BUCKETS; ++b) total += m_hist[b];
+    uint32_t want = (total * pct + 99) / 100;
+    if (want == 0) return 0;
+    for (uint8_t b = 0; b < LAT_BUCKETS; ++b) {
+        n += m_hist[b];
+        if (n >= want) {
+            uint32_t u = upper (b);
+            return u < m_max ? u : m_max;
+        }
+    }
+    return m_max;
+}
+
+void
+CLatencyTrace::reset ()
+{
+    for (uint8_t i = 0; i < LAT_PATHS; ++i) m_stats[i].reset ();
+    m_glass = m_output = false;
+    m_edge = m_query = 0;
+}
+
+void
+CLatencyTrace::knob (uint32_t edge, uint32_t query)
+{
+    if (m_glass || m_output) return;
+    m_edge = edge;
+    m_query = query;
+    m_glass = m_output = true;
+    m_stats[LAT_QUERY].add (us (edge, query));
+}
+
+void
+CLatencyTrace::frame (uint32_t begin, uint32_t end)
+{
+    // only a frame begun after the query surely shows the event
+    if (!m_glass || ((int32_t) (begin - m_query) < 0)) return;
+    m_stats[LAT_GLASS].add (us (m_edge, end));
+    m_glass = false;
+}
+
+void
+CLatencyTrace::output (uint32_t stamp)
+{
+    if (!m_output || ((int32_t) (stamp - m_query) <= 0)) return;
+    m_stats[LAT_OUTPUT].add (us (m_edge, stamp));
+    m_output = false;
+}
+
+void
+CLatencyTrace::expire (uint32_t now)
+{
+    if ((m_glass || m_output) && (us (m_query, now) > LAT_TIMEOUT_US))
+        m_glass = m_output = false;
+}
+
+void
+CLatencyTrace::report (uint8_t line, char *buf) const
+{
+    static const char *const names[LAT_PATHS] = { "query", "glass", "output" };
+    if (line == 0) {
+        strcpy (buf, "ms      p50  p90  p99  max");
+        return;
+    }
+    if (line > LAT_PATHS) {
+        snprintf (buf, 27, "n %u/%u/%u", (unsigned) m_stats[0].count (),
+                  (unsigned) m_stats[1].count (), (unsigned) m_stats[2].count ());
+        return;
+    }
+    const CLatencyStats &s = m_stats[line - 1];
+    uint32_t v[4] = { s.percentile (50), s.percentile (90), 
+                      s.percentile (99), s.max () };
+    int n = snprintf (buf, 27, "%-6s", names[line - 1]);
+    for (uint8_t i = 0; i < 4; ++i) {
+        // ms with one decimal below 100 ms, whole ms above
+        uint32_t t = (v[i] + 50) / 100;
+        if (t < 1000)
+            n += snprintf (buf + n, 27 - n, "%3u.%u", (unsigned) (t / 10), 
+                           (unsigned) (t % 10));
+        else
+            n += snprintf (buf + n, 27 - n, "%5u", (unsigned) (t / 10));
+    }
+}
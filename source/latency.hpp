@@ -0,0 +1,105 @@
+/// @file latency.hpp
+/// @brief Latency histograms and knob-to-glass/output traces
+
+#ifndef _LATENCY_HPP_
+#define _LATENCY_HPP_
+
+#include <stdint.h>
+
+#define LAT_SUB 8                   ///< histogram buckets per octave
+#define LAT_BUCKETS (LAT_SUB * 19)  ///< buckets up to 2^20 us, about 1 s
+#define LAT_TIMEOUT_US 500000       ///< trace ends unmatched after this
+#define LAT_LINES 5                 ///< lines of report()
+
+/// @brief Latency paths, all starting at the first knob edge of an event
+enum lat_path_t {
+    LAT_QUERY = 0,      ///< until CKnob::query() returned the event
+    LAT_GLASS,          ///< until a frame rendered after the query was sent
+    LAT_OUTPUT,         ///< until output parameters set after the query play
+    LAT_PATHS
+};
+
+/// @brief Class collecting latencies into a histogram with LAT_SUB 
+///        logarithmic buckets per octave, so percentiles are exact to 
+///        1/LAT_SUB of their value whatever the range
+class CLatencyStats {
+public:
+    /// @brief Default constructor, empty
+    CLatencyStats () { reset (); }
+
+    /// @brief Remove all samples
+    void reset ();
+
+    /// @brief Add a sample in us
+    void add (uint32_t us);
+
+    /// @brief Get a percentile in us, rounded up to its bucket
+    /// @param pct  Percentage 1..100
+    uint32_t percentile (uint8_t pct) const;
+
+    /// @brief Get the number of samples
+    uint32_t count () const { return m_count; }
+
+    /// @brief Get the largest sample in us
+    uint32_t max () const { return m_max; }
+
+protected:
+    static uint8_t bucket (uint32_t us);
+    static uint32_t upper (uint8_t b);
+
+protected:
+    uint16_t m_hist[LAT_BUCKETS];   ///< samples per bucket, saturating
+    uint32_t m_count;               ///< samples
+    uint32_t m_max;                 ///< largest sample
+};
+
+/// @brief Class matching knob events with the frames and output updates
+///        that follow them. All times are cycle counter stamps; only one 
+///        event is traced at a time, later ones wait until it completes.
+class CLatencyTrace {
+public:
+    /// @brief Constructor
+    /// @param cyclesperus  Cycle counter ticks per us
+    CLatencyTrace (uint32_t cyclesperus) : m_perus (cyclesperus) { reset (); }
+
+    /// @brief Remove all samples and end the open trace
+    void reset ();
+
+    /// @brief A query returned a knob event
+    /// @param edge   Time of the event's first edge
+    /// @param query  Time of the query
+    void knob (uint32_t edge, uint32_t query);
+
+    /// @brief A frame that sent rows to the panel finished
+    /// @param begin  Time the frame began; rows dirtied before are in it
+    /// @param end    Time the frame's last row was sent
+    void frame (uint32_t begin, uint32_t end);
+
+    /// @brief Output parameters started to play
+    void output (uint32_t stamp);
+
+    /// @brief End the trace if it waited too long for a frame or output,
+    ///        e.g. because the event changed neither
+    void expire (uint32_t now);
+
+    /// @brief Get the statistics of a path
+    const CLatencyStats &stats (uint8_t path) const { return m_stats[path]; }
+
+    /// @brief Format a line of the report, a table of percentiles in ms
+    /// @param line  0 <= line < LAT_LINES
+    /// @param buf   Destination, at least 27 characters
+    void report (uint8_t line, char *buf) const;
+
+protected:
+    uint32_t us (uint32_t from, uint32_t to) const { return (to - from) / m_perus; }
+
+protected:
+    CLatencyStats m_stats[LAT_PATHS];   ///< statistics per path
+    uint32_t m_perus;                   ///< cycle counter ticks per us
+    uint32_t m_edge;                    ///< first edge of the traced event
+    uint32_t m_query;                   ///< query of the traced event
+    bool     m_glass;                   ///< waiting for a frame
+    bool     m_output;                  ///< waiting for an output update
+};
+
+#endif // _LATENCY_HPP_
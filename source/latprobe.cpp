@@ -0,0 +1,74 @@
+/// @file latprobe.cpp
+/// @brief Knob-to-glass and knob-to-output latency tracing on the Due
+
+#include "Arduino.h"
+#include "cycles.hpp"
+#include "knob.hpp"
+#include "synth.hpp"
+#include "latprobe.hpp"
+
+CLatencyProbe CLatencyProbe::s_singleton;
+
+void
+CLatencyProbe::begin (TextFrameBuffer *tfb)
+{
+    cycles_begin ();
+    m_tfb = tfb;
+    m_query = CKnob::get ()->queryStamp ();
+    m_frames = tfb->frames ();
+    m_applied = CSynth::get ()->appliedStamp ();
+    m_trace.reset ();
+}
+
+void
+CLatencyProbe::poll ()
+{
+    if (!m_tfb) return;
+    CKnob *knob = CKnob::get ();
+    if (knob->queryStamp () != m_query) {
+        m_query = knob->queryStamp ();
+        m_trace.knob (knob->eventStamp (), m_query);
+    }
+    if (m_tfb->frames () != m_frames) {
+        m_frames = m_tfb->frames ();
+        m_trace.frame (m_tfb->frameBegin (), m_tfb->frameStamp ());
+    }
+    uint32_t applied = CSynth::get ()->appliedStamp ();
+    if (applied != m_applied) {
+        m_applied = applied;
+        m_trace.output (applied);
+    }
+    m_trace.expire (cycles ());
+}
+
+CLatencyProbe::CLatencyProbe ()
+: m_trace (CYCLES_PER_US), m_tfb (0), m_query (0), m_frames (0), 
+  m_applied (0)
+{
+}
+
+bool
+CLatencyView::changed ()
+{
+    uint32_t n = 0;
+    for (uint8_t p = 0; p < LAT_PATHS; ++p) n += m_trace.stats (p).count ();
+    if (n == m_count) return false;
+    m_count = n;
+    return true;
+}
+
+void
+CLatencyView::draw (TextFrameBuffer *tfb, uint8_t at)
+{
+    uint8_t old = tfb->textAttr ();
+    tfb->textAttr (at);
+    for (uint8_t i = 0; i < LAT_LINES; ++i) {
+        char line[27];
+        m_trace.report (i, line);
+        // pad shorter lines so they clear old text
+        for (uint8_t c = strlen (line); c < 26; ++c) line[c] = ' ';
+        line[26] = 0;
+        tfb->textOut (m_x, m_y + i, line, m_w);
+    }
+    tfb->textAttr (old);
+}
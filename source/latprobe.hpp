@@ -0,0 +1,62 @@
+/// @file latprobe.hpp
+/// @brief Knob-to-glass and knob-to-output latency tracing on the Due
+
+#ifndef _LATPROBE_HPP_
+#define _LATPROBE_HPP_
+
+#include "latency.hpp"
+#include "widget.hpp"
+
+/// @brief Class feeding a CLatencyTrace from the cycle counter stamps of
+///        CKnob, TextFrameBuffer and CSynth. The knob stamps its first 
+///        edge in the interrupt and the query that returns it, the frame
+///        buffer the end of each frame's DMA, and the synth the start of 
+///        the block taking a modulator update. The glass latency ends when
+///        the panel RAM holds the frame, not when the panel next scans it.
+class CLatencyProbe {
+public:
+    /// @brief Return the singleton CLatencyProbe object
+    /// @return Pointer to the singleton CLatencyProbe object
+    static CLatencyProbe *get () { return &s_singleton; }
+
+    /// @brief Start tracing
+    /// @param tfb  Frame buffer whose frames end the glass path
+    void begin (TextFrameBuffer *tfb);
+
+    /// @brief Collect new stamps. Call after CKnob::query() and after 
+    ///        rendering, once per main loop iteration or scheduler pass.
+    void poll ();
+
+    /// @brief Get the trace with the statistics
+    CLatencyTrace &trace () { return m_trace; }
+
+protected:
+    /// @brief Default constructor
+    CLatencyProbe ();
+
+protected:
+    static CLatencyProbe s_singleton;   ///< The singleton probe
+
+    CLatencyTrace m_trace;              ///< statistics
+    TextFrameBuffer *m_tfb;             ///< traced frame buffer
+    uint32_t m_query;                   ///< last CKnob::queryStamp() seen
+    uint32_t m_frames;                  ///< last frames() seen
+    uint32_t m_applied;                 ///< last appliedStamp() seen
+};
+
+/// @brief Widget showing the percentile table of a trace in LAT_LINES 
+///        rows of 26 characters, redrawn when samples were added
+class CLatencyView : public CWidget {
+public:
+    CLatencyView (coord_t x, coord_t y, const CLatencyTrace &trace, uint8_t at)
+    : CWidget (x, y, 26, at), m_trace (trace), m_count (0) {}
+
+    virtual bool changed ();
+    virtual void draw (TextFrameBuffer *tfb, uint8_t at);
+
+protected:
+    const CLatencyTrace &m_trace;       ///< trace shown
+    uint32_t m_count;                   ///< samples shown
+};
+
+#endif // _LATPROBE_HPP_
@@ -0,0 +1,163 @@
+/// @file modulate.cpp
+/// @brief Block-rate level ramps, ADSR envelopes and LFOs per channel
+
+#include <string.h>
+#include "wavegen.hpp"
+#include "modulate.hpp"
+
+#define ENV_FLOOR 256           ///< Q24 envelope level treated as silence
+
+CModulator::CModulator ()
+: m_seq (0), m_blockrate (1), m_serial (0), m_applied (0), m_value (0), m_step (0), m_left (0),
+  m_env (MOD_ONE), m_lfophase (0), m_envstate (ENV_OFF)
+{
+    memset (&m_shared, 0, sizeof (m_shared));
+    m_shared.rate = 1;
+    m_p = m_shared;
+}
+
+uint32_t
+CModulator::blocks (uint32_t ms) const
+{
+    uint32_t n = (uint32_t) (((uint64_t) ms * m_blockrate + 500) / 1000);
+    return n ? n : 1;
+}
+
+uint32_t
+CModulator::coefficient (uint32_t ms) const
+{
+    // first-order lag reaching 63% after ms; exact enough for n >> 1
+    return 65536 / blocks (ms);
+}
+
+void
+CModulator::rampTo (uint16_t level, uint32_t ms, uint8_t ramp)
+{
+    begin_update ();
+    m_shared.target = (uint32_t) level << 9;
+    m_shared.ramp = ramp;
+    m_shared.rate = (ramp == RAMP_EXP) ? coefficient (ms) : blocks (ms);
+    ++m_shared.rampserial;
+    end_update ();
+}
+
+void
+CModulator::follow (mod_source_t *src, uint32_t ms)
+{
+    begin_update ();
+    m_shared.source = src;
+    m_shared.ramp = RAMP_EXP;
+    m_shared.rate = ms ? coefficient (ms) : 65536;
+    end_update ();
+}
+
+void
+CModulator::envelope (uint32_t attackms, uint32_t decayms, uint16_t sustain,
+                      uint32_t releasems)
+{
+    begin_update ();
+    m_shared.attack = MOD_ONE / blocks (attackms);
+    m_shared.decay = coefficient (decayms);
+    m_shared.sustain = (uint32_t) sustain << 9;
+    m_shared.release = coefficient (releasems);
+    end_update ();
+}
+
+void
+CModulator::gate (bool on)
+{
+    begin_update ();
+    m_shared.gate = on;
+    end_update ();
+}
+
+void
+CModulator::lfo (uint32_t millihz, uint16_t depth)
+{
+    begin_update ();
+    m_shared.lfoinc = (uint32_t) (((uint64_t) millihz << 32) / ((uint64_t) m_blockrate * 1000));
+    m_shared.depth = depth;
+    end_update ();
+}
+
+uint16_t
+CModulator::next ()
+{
+    // take the mailbox unless the main loop is in the middle of an update
+    uint32_t seq = m_seq;
+    if (!(seq & 1)) {
+        __sync_synchronize ();
+        params_t p = m_shared;
+        __sync_synchronize ();
+        if (m_seq == seq) {
+            m_p = p;
+            m_applied = seq;
+        }
+    }
+
+    // level ramp, towards the followed level if any
+    if (m_p.source) {
+        // stamp first, @see mod_source_t
+        uint32_t stamp = m_p.source->stamp;
+        __sync_synchronize ();
+        m_p.target = (uint32_t) m_p.source->level << 9;
+        m_p.source->taken = stamp;
+    }
+    if ((m_p.rampserial != m_serial) && (m_p.ramp == RAMP_LINEAR)) {
+        m_left = m_p.rate;
+        m_step = ((int32_t) m_p.target - (int32_t) m_value) / (int32_t) m_left;
+    }
+    m_serial = m_p.rampserial;
+    if (m_p.ramp == RAMP_LINEAR) {
+        if (m_left > 0) 
+            m_value = (--m_left == 0) ? m_p.target : m_value + m_step;
+    } else {
+        int32_t d = (int32_t) m_p.target - (int32_t) m_value;
+        int32_t step = (int32_t) (((int64_t) d * m_p.rate) >> 16);
+        m_value = (step != 0) ? m_value + step : m_p.target;
+    }
+
+    // envelope; without attack configured it stays at one
+    if (m_p.attack == 0) {
+        m_env = MOD_ONE;
+        m_envstate = ENV_OFF;
+    } else {
+        if (m_envstate == ENV_OFF) {
+            // newly configured: start silent until the gate opens
+            m_env = 0;
+            m_envstate = ENV_RELEASE;
+        }
+        if (m_p.gate && (m_envstate == ENV_RELEASE))
+            m_envstate = ENV_ATTACK;
+        else if (!m_p.gate && (m_envstate != ENV_RELEASE))
+            m_envstate = ENV_RELEASE;
+        switch (m_envstate) {
+        case ENV_ATTACK:
+            m_env += m_p.attack;
+            if (m_env >= MOD_ONE) {
+                m_env = MOD_ONE;
+                m_envstate = ENV_DECAY;
+            }
+            break;
+        case ENV_DECAY:
+            m_env += (int32_t) (((int64_t) ((int32_t) m_p.sustain - (int32_t) m_env) * m_p.decay) >> 16);
+            break;
+        case ENV_RELEASE:
+            m_env -= (uint32_t) (((uint64_t) m_env * m_p.release) >> 16);
+            if (m_env < ENV_FLOOR) m_env = 0;
+            break;
+        default:
+            break;
+        }
+    }
+
+    // combine level, envelope and LFO
+    uint32_t out = ((m_value >> 9) * (m_env >> 9)) >> 15;
+    if (m_p.depth) {
+        m_lfophase += m_p.lfoinc;
+        int32_t s = CWaveVoice::table (WAVE_SINE)[m_lfophase >> (32 - WAVE_BITS)];
+        uint32_t m = 32768 - (((uint32_t) m_p.depth * (uint32_t) (32768 - s)) >> 16);
+        out = (out * m) >> 15;
+    }
+    return out;
+}
@@ -0,0 +1,126 @@
+/// @file modulate.hpp
+/// @brief Block-rate level ramps, ADSR envelopes and LFOs per channel
+
+#ifndef _MODULATE_HPP_
+#define _MODULATE_HPP_
+
+#include <stdint.h>
+
+#define MOD_ONE (1UL << 24)     ///< unity of the internal Q24 levels
+
+/// @brief An external level followed by CModulator, e.g. from an envelope
+///        follower. Written by its producer, read by the refill interrupt,
+///        which may preempt the producer: the producer stores level, then
+///        a barrier, then stamp; the reader loads them in reverse order.
+struct mod_source_t {
+    volatile uint16_t level;    ///< Q15 level to follow
+    volatile uint32_t stamp;    ///< producer timestamp of level
+    volatile uint32_t taken;    ///< stamp of the level last taken by next()
+    volatile uint32_t delay;    ///< cycles from stamp until the level was taken
+    volatile uint32_t maxdelay; ///< largest delay seen
+};
+
+/// @brief Class computing the level of one output channel once per block.
+///        The main loop sets targets with rampTo(), envelope(), gate() and
+///        lfo(); the refill interrupt calls next(). Parameters pass through
+///        a sequence-locked mailbox, so neither side ever waits: a block
+///        that interrupts an update keeps the previous parameters.
+class CModulator {
+public:
+    enum ramp_t {
+        RAMP_LINEAR = 0,    ///< constant slope, arrives after the given time
+        RAMP_EXP            ///< first-order lag, time is the time constant
+    };
+
+public:
+    /// @brief Default constructor, level zero, no envelope, no LFO
+    CModulator ();
+
+    /// @brief Set the number of next() calls per second
+    /// @param blockrate  Blocks per second, i.e. sample rate / block size
+    void setBlockRate (uint32_t blockrate) { m_blockrate = blockrate; }
+
+    /// @brief Ramp the level to a target (main loop only)
+    /// @param level  Target Q15 level, 32768 = full scale
+    /// @param ms     Ramp time in ms, 0 for the next block
+    /// @param ramp   One of ramp_t
+    void rampTo (uint16_t level, uint32_t ms, uint8_t ramp = RAMP_LINEAR);
+
+    /// @brief Follow an external level instead of rampTo() targets (main 
+    ///        loop only). The level is smoothed with the given time constant.
+    /// @param src  Source to follow, or 0 to return to rampTo() targets
+    /// @param ms   Smoothing time constant in ms, 0 for none
+    void follow (mod_source_t *src, uint32_t ms);
+
+    /// @brief Get the followed source, or 0
+    mod_source_t *source () const { return m_p.source; }
+
+    /// @brief Configure the ADSR envelope applied on top of the level
+    ///        (main loop only). Without a call the envelope is constant 1.
+    /// @param attackms   Linear attack time to full scale in ms
+    /// @param decayms    Decay time constant in ms
+    /// @param sustain    Sustain Q15 level
+    /// @param releasems  Release time constant in ms
+    void envelope (uint32_t attackms, uint32_t decayms, uint16_t sustain,
+                   uint32_t releasems);
+
+    /// @brief Start (attack) or end (release) the envelope (main loop only)
+    void gate (bool on);
+
+    /// @brief Configure the LFO scaling the level between 1 - depth and 1
+    ///        (main loop only)
+    /// @param millihz  LFO frequency in mHz
+    /// @param depth    Q15 modulation depth, 0 disables the LFO
+    void lfo (uint32_t millihz, uint16_t depth);
+
+    /// @brief Advance by one block (refill interrupt only)
+    /// @return Q15 level at the end of the block
+    uint16_t next ();
+
+    /// @brief Get the ramped level before envelope and LFO as Q15
+    uint16_t level () const { return m_value >> 9; }
+
+    /// @brief Get the update number of the parameters in use by next(); 
+    ///        it changes in the block a main loop update takes effect
+    uint32_t applied () const { return m_applied; }
+
+protected:
+    /// @brief Parameters written by the main loop, read by next()
+    struct params_t {
+        uint32_t target;        ///< Q24 ramp target
+        uint32_t rate;          ///< blocks (linear) or Q16 coefficient (exp)
+        uint32_t rampserial;    ///< incremented on each rampTo()
+        uint32_t attack;        ///< Q24 attack increment per block
+        uint32_t decay;         ///< Q16 decay coefficient per block
+        uint32_t sustain;       ///< Q24 sustain level
+        uint32_t release;       ///< Q16 release coefficient per block
+        uint32_t lfoinc;        ///< LFO phase increment per block
+        mod_source_t *source;   ///< followed level, or 0
+        uint16_t depth;         ///< Q15 LFO depth
+        uint8_t  ramp;          ///< ramp_t
+        uint8_t  gate;          ///< envelope gate
+    };
+
+    enum env_state_t { ENV_OFF, ENV_ATTACK, ENV_DECAY, ENV_RELEASE };
+
+    void begin_update () { ++m_seq; __sync_synchronize (); }
+    void end_update () { __sync_synchronize (); ++m_seq; }
+    uint32_t blocks (uint32_t ms) const;
+    uint32_t coefficient (uint32_t ms) const;
+
+protected:
+    volatile uint32_t m_seq;    ///< odd while the main loop updates m_shared
+    params_t m_shared;          ///< mailbox written by the main loop
+    params_t m_p;               ///< parameters in use by next()
+    uint32_t m_blockrate;       ///< next() calls per second
+    uint32_t m_serial;          ///< rampserial of the ramp in progress
+    uint32_t m_applied;         ///< m_seq of the parameters in m_p
+    uint32_t m_value;           ///< Q24 ramped level
+    int32_t  m_step;            ///< Q24 linear ramp step per block
+    uint32_t m_left;            ///< blocks left of the linear ramp
+    uint32_t m_env;             ///< Q24 envelope level
+    uint32_t m_lfophase;        ///< LFO phase, one cycle = 2^32
+    uint8_t  m_envstate;        ///< env_state_t
+};
+
+#endif // _MODULATE_HPP_
@@ -0,0 +1,116 @@
+/// @file power.cpp
+/// @brief Panel and CPU low-power modes with knob wake-up
+
+#include "SPI.hpp"
+#include "knob.hpp"
+#include "power.hpp"
+
+// SAM3X8E at 84 MHz from the datasheet typicals, in uA
+#define CPU_RUN_UA   60000  ///< all peripheral clocks used here running
+#define CPU_WFI_UA   25000  ///< sleep mode, clocks running, core halted
+
+CPower CPower::s_singleton;
+
+// ST7735 logic supply from the datasheet typicals, in uA; backlight excluded
+const uint32_t CPower::s_panelua[POWER_MODES] = {
+    7000,   // POWER_ACTIVE: normal mode, 262k colors
+    1800,   // POWER_DIM: idle + partial mode
+    10      // POWER_SLEEP: sleep in
+};
+
+void
+CPower::configure (Adafruit_ST7735 *tft, uint32_t dimms, uint32_t sleepms,
+                   coord_t r0, coord_t r1)
+{
+    m_tft = tft;
+    m_dimms = dimms;
+    m_sleepms = sleepms;
+    m_r0 = r0;
+    m_r1 = r1;
+    m_lastevent = millis ();
+    m_edges = CKnob::get ()->edges ();
+    m_since = micros ();
+    m_slept = 0;
+    // idle waits for DMA transfers sleep as well
+    SPI.sleepOnWait (true);
+}
+
+void
+CPower::setMode (uint8_t mode)
+{
+    if ((mode == m_mode) || (mode >= POWER_MODES) || !m_tft) return;
+    // the panel takes no other command until it is fully awake
+    if (waking ()) return;
+    // leave the current mode
+    if (m_mode == POWER_SLEEP) {
+        m_tft->displaySleep (false);
+        m_wakestart = millis ();
+        m_waking = true;
+    } else if (m_mode == POWER_DIM) {
+        m_tft->displayIdle (false);
+        m_tft->displayNormal ();
+    }
+    // enter the new one
+    if (mode == POWER_DIM) {
+        m_tft->displayPartial (m_r0, m_r1);
+        m_tft->displayIdle (true);
+    } else if (mode == POWER_SLEEP) {
+        m_tft->displaySleep (true);
+    }
+    m_mode = mode;
+}
+
+bool
+CPower::poll ()
+{
+    uint32_t now = millis ();
+    // edges rather than pending(), which query() clears
+    uint32_t edges = CKnob::get ()->edges ();
+    if (edges != m_edges) {
+        m_edges = edges;
+        m_lastevent = now;
+        setMode (POWER_ACTIVE);
+    } else if (m_sleepms && (now - m_lastevent >= m_sleepms)) {
+        setMode (POWER_SLEEP);
+    } else if (m_dimms && (now - m_lastevent >= m_dimms)) {
+        setMode (POWER_DIM);
+    }
+    return (m_mode != POWER_SLEEP) && !waking ();
+}
+
+bool
+CPower::waking ()
+{
+    if (m_waking && (millis () - m_wakestart >= POWER_WAKE_MS)) 
+        m_waking = false;
+    return m_waking;
+}
+
+void
+CPower::waitForInterrupt ()
+{
+    uint32_t t0 = micros ();
+    __WFI ();
+    m_slept += micros () - t0;
+}
+
+uint32_t
+CPower::estimatedCurrent ()
+{
+    uint32_t now = micros ();
+    uint32_t span = now - m_since;
+    uint32_t slept = min (m_slept, span);
+    m_since = now;
+    m_slept = 0;
+    if (span == 0) return s_panelua[m_mode] + CPU_RUN_UA;
+    uint32_t cpu = (uint32_t) (((uint64_t) CPU_RUN_UA * (span - slept) 
+                              + (uint64_t) CPU_WFI_UA * slept) / span);
+    return s_panelua[m_mode] + cpu;
+}
+
+CPower::CPower ()
+: m_tft (0), m_dimms (0), m_sleepms (0), m_lastevent (0), m_edges (0),
+  m_slept (0), m_since (0), m_wakestart (0), m_r0 (0), m_r1 (0), 
+  m_mode (POWER_ACTIVE), m_waking (false)
+{
+}
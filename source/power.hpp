@@ -0,0 +1,87 @@
+/// @file power.hpp
+/// @brief Panel and CPU low-power modes with knob wake-up
+
+#ifndef _POWER_HPP_
+#define _POWER_HPP_
+
+#include "ST7735.hpp"
+
+#define POWER_WAKE_MS 120       ///< panel wake-up time after sleep out
+
+/// @brief Class managing panel power modes and CPU idle waits
+class CPower {
+public:
+    enum power_mode_t {
+        POWER_ACTIVE = 0,   ///< full color, full panel, CPU runs
+        POWER_DIM,          ///< 8 color idle mode on a partial panel area
+        POWER_SLEEP,        ///< panel asleep, showing nothing
+        POWER_MODES
+    };
+
+public:
+    /// @brief Return the singleton CPower object
+    /// @return Pointer to the singleton CPower object
+    static CPower *get () { return &s_singleton; }
+
+    /// @brief Configure the power manager
+    /// @param tft      Display to control
+    /// @param dimms    Inactivity in ms before entering POWER_DIM, 0 = never
+    /// @param sleepms  Inactivity in ms before entering POWER_SLEEP, 0 = never
+    /// @param r0       First panel gate row kept on in POWER_DIM
+    /// @param r1       Last panel gate row kept on in POWER_DIM
+    void configure (Adafruit_ST7735 *tft, uint32_t dimms, uint32_t sleepms,
+                    coord_t r0, coord_t r1);
+
+    /// @brief Switch the panel to a power mode. Ignored while the panel 
+    ///        wakes from POWER_SLEEP; poll() retries on its next call.
+    void setMode (uint8_t mode);
+
+    /// @brief Get the current power mode
+    uint8_t mode () const { return m_mode; }
+
+    /// @brief Update the mode from knob activity and inactivity timeouts.
+    ///        Call once per main loop iteration, before or after 
+    ///        CKnob::query(): any knob edge since the previous call
+    ///        returns to POWER_ACTIVE; leaving POWER_DIM is immediate. 
+    ///        Leaving POWER_SLEEP takes the panel POWER_WAKE_MS, during 
+    ///        which poll() returns false without waiting.
+    /// @return true if the panel is awake and should be rendered to
+    bool poll ();
+
+    /// @brief Sleep the CPU until the next interrupt, i.e. a knob edge, 
+    ///        a DMAC completion or the 1 ms system tick
+    void waitForInterrupt ();
+
+    /// @brief Estimated supply current of the panel in a mode, in uA
+    static uint32_t panelCurrent (uint8_t mode) { return s_panelua[mode]; }
+
+    /// @brief Estimated supply current of panel and CPU in uA, weighting
+    ///        CPU run and sleep current by the time spent in 
+    ///        waitForInterrupt() since the previous call
+    uint32_t estimatedCurrent ();
+
+protected:
+    /// @brief Default constructor
+    CPower ();
+
+    /// @brief Get whether the panel still wakes from POWER_SLEEP
+    bool waking ();
+
+protected:
+    static CPower s_singleton;          ///< The singleton power object
+    static const uint32_t s_panelua[POWER_MODES];  ///< panel current per mode
+
+    Adafruit_ST7735 *m_tft;             ///< display controlled
+    uint32_t m_dimms;                   ///< inactivity timeout to POWER_DIM
+    uint32_t m_sleepms;                 ///< inactivity timeout to POWER_SLEEP
+    uint32_t m_lastevent;               ///< millis() of last knob event
+    uint32_t m_edges;                   ///< CKnob::edges() at the last poll()
+    uint32_t m_slept;                   ///< us spent in waitForInterrupt()
+    uint32_t m_since;                   ///< micros() of last estimatedCurrent()
+    uint32_t m_wakestart;               ///< millis() of the sleep out command
+    coord_t  m_r0, m_r1;                ///< partial area kept on in POWER_DIM
+    uint8_t  m_mode;                    ///< current power mode
+    bool     m_waking;                  ///< panel wakes from POWER_SLEEP
+};
+
+#endif // _POWER_HPP_
@@ -0,0 +1,81 @@
+/// @file preset.cpp
+/// @brief Channel programs, envelopes and UI state stored as presets in
+///        the SAM3X internal flash
+
+#include "Arduino.h"
+#include "preset.hpp"
+
+#define PRESET_ADDR (IFLASH1_ADDR + IFLASH1_SIZE - PRESET_PAGES * IFLASH1_PAGE_SIZE)
+#define PRESET_FIRST ((PRESET_ADDR - IFLASH1_ADDR) / IFLASH1_PAGE_SIZE)
+
+#define FCMD_EWP 0x03           ///< erase page and write page
+#define FCMD_CLB 0x09           ///< clear lock bit
+#define LOCK_PAGES 64           ///< pages per lock region
+
+CPresetStore CPresetStore::s_singleton;
+
+static uint32_t
+eefc_command (uint32_t cmd, uint32_t arg)
+{
+    uint32_t sr;
+    EFC1->EEFC_FCR = EEFC_FCR_FKEY (0x5A) | EEFC_FCR_FARG (arg) 
+        | EEFC_FCR_FCMD (cmd);
+    while (!((sr = EFC1->EEFC_FSR) & EEFC_FSR_FRDY)) ;
+    return sr;
+}
+
+bool
+CPresetStore::program (uint16_t page, const uint32_t *data)
+{
+    // fill the page latch through the mapped address, then commit it
+    volatile uint32_t *dst = (volatile uint32_t *) 
+        (PRESET_ADDR + (uint32_t) page * IFLASH1_PAGE_SIZE);
+    for (uint16_t i = 0; i < IFLASH1_PAGE_SIZE / 4; ++i)
+        dst[i] = data[i];
+    uint32_t sr = eefc_command (FCMD_EWP, PRESET_FIRST + page);
+    return !(sr & (EEFC_FSR_FCMDE | EEFC_FSR_FLOCKE));
+}
+
+uint8_t
+CPresetStore::begin ()
+{
+    // 6 wait states are needed to program at 84 MHz; bank 1 holds only 
+    // the log, so its slower reads do not affect the sketch
+    EFC1->EEFC_FMR = (EFC1->EEFC_FMR & ~EEFC_FMR_FWS_Msk) | EEFC_FMR_FWS (6);
+    for (uint32_t p = PRESET_FIRST; p < PRESET_FIRST + PRESET_PAGES; 
+         p += LOCK_PAGES)
+        eefc_command (FCMD_CLB, p);
+    return m_log.begin ((const uint8_t *) PRESET_ADDR, PRESET_PAGES, 
+                        program);
+}
+
+bool
+CPresetStore::save (uint8_t slot, const preset_t &p)
+{
+    if (slot >= PRESET_SLOTS) return false;
+    return m_log.save (slot, &p, sizeof (p));
+}
+
+bool
+CPresetStore::load (uint8_t slot, preset_t &p) const
+{
+    if (m_log.length (slot) != sizeof (p)) return false;
+    m_log.load (slot, &p, sizeof (p));
+    return p.version == PRESET_VERSION;
+}
+
+void
+CPresetStore::apply (const preset_t &p)
+{
+    CSynth *synth = CSynth::get ();
+    for (uint8_t ch = 0; ch < SYNTH_CHANNELS; ++ch) {
+        const preset_t::channel_t &c = p.ch[ch];
+        CWaveVoice &v = synth->voice (ch);
+        v.setShape (c.shape);
+        v.setFrequency (c.millihz, synth->rate ());
+        CModulator &m = synth->modulator (ch);
+        m.envelope (c.attackms, c.decayms, c.sustain, c.releasems);
+        m.lfo (c.lfomillihz, c.lfodepth);
+        m.rampTo (c.level, 0);
+    }
+}
@@ -0,0 +1,84 @@
+/// @file preset.hpp
+/// @brief Channel programs, envelopes and UI state stored as presets in
+///        the SAM3X internal flash
+
+#ifndef _PRESET_HPP_
+#define _PRESET_HPP_
+
+#include "presetlog.hpp"
+#include "synth.hpp"
+
+#ifndef PRESET_PAGES
+#define PRESET_PAGES 64         ///< log pages reserved at the end of flash
+#endif
+
+#define PRESET_SLOTS 16         ///< preset numbers 0..PRESET_SLOTS-1
+#define PRESET_VERSION 1        ///< layout version of preset_t
+
+/// @brief A preset as stored, one flash page
+struct preset_t {
+    /// @brief Program of one output channel
+    struct channel_t {
+        uint32_t millihz;       ///< oscillator frequency in mHz
+        uint32_t lfomillihz;    ///< LFO frequency in mHz
+        uint16_t level;         ///< Q15 level
+        uint16_t lfodepth;      ///< Q15 LFO depth, 0 = off
+        uint16_t attackms;      ///< envelope attack in ms
+        uint16_t decayms;       ///< envelope decay in ms
+        uint16_t sustain;       ///< Q15 envelope sustain level
+        uint16_t releasems;     ///< envelope release in ms
+        uint8_t  shape;         ///< wave_shape_t
+        uint8_t  reserved[3];
+    } ch[SYNTH_CHANNELS];
+    uint8_t version;            ///< PRESET_VERSION
+    uint8_t page;               ///< text frame buffer page shown
+    uint8_t rotation;           ///< display rotation
+    uint8_t reserved;
+};
+
+/// @brief Class storing presets in a wear-leveled log in the last 
+///        PRESET_PAGES pages of flash bank 1. The sketch runs from bank 0,
+///        so interrupts keep running from flash while a page programs 
+///        (about 4 ms). After begin() a preset loads with one copy from 
+///        memory-mapped flash.
+class CPresetStore {
+public:
+    /// @brief Return the singleton CPresetStore object
+    /// @return Pointer to the singleton CPresetStore object
+    static CPresetStore *get () { return &s_singleton; }
+
+    /// @brief Unlock the flash region and index the stored presets
+    /// @return Number of stored presets
+    uint8_t begin ();
+
+    /// @brief Store a preset, replacing a previous one in the slot
+    /// @param slot  Preset number, < PRESET_SLOTS
+    /// @param p     Preset to store
+    /// @return      false if programming failed
+    bool save (uint8_t slot, const preset_t &p);
+
+    /// @brief Load a preset
+    /// @param slot  Preset number, < PRESET_SLOTS
+    /// @param p     Destination
+    /// @return      false if the slot is empty or of another version
+    bool load (uint8_t slot, preset_t &p) const;
+
+    /// @brief Apply the channel programs of a preset to the synthesizer
+    static void apply (const preset_t &p);
+
+    /// @brief Get the record log, e.g. for records other than presets
+    CPresetLog &log () { return m_log; }
+
+protected:
+    /// @brief Default constructor
+    CPresetStore () {}
+
+    static bool program (uint16_t page, const uint32_t *data);
+
+protected:
+    static CPresetStore s_singleton;    ///< The singleton preset store
+
+    CPresetLog m_log;                   ///< log in flash
+};
+
+#endif // _PRESET_HPP_
@@ -0,0 +1,173 @@
+/// @file presetlog.cpp
+/// @brief Wear-leveled append-only record log on page-erased flash
+
+#include <string.h>
+#include "presetlog.hpp"
+
+#define NOPAGE 0xFFFF       ///< index entry of an id without record
+
+CPresetLog::CPresetLog ()
+: m_base (0), m_program (0), m_pages (0), m_head (0), m_seq (0), 
+  m_writes (0), m_live (0)
+{
+    memset (m_index, 0xFF, sizeof (m_index));
+    memset (m_owner, NONE, sizeof (m_owner));
+}
+
+uint32_t
+CPresetLog::crc32 (const void *data, uint32_t len, uint32_t crc)
+{
+    // half-byte table, a compromise between flash size and speed
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+        0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+        0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+    const uint8_t *p = (const uint8_t *) data;
+    crc = ~crc;
+    while (len-- > 0) {
+        crc ^= *p++;
+        crc = (crc >> 4) ^ table[crc & 15];
+        crc = (crc >> 4) ^ table[crc & 15];
+    }
+    return ~crc;
+}
+
+uint32_t
+CPresetLog::checksum (const record_t &r)
+{
+    uint32_t crc = crc32 (&r, 8);
+    return crc32 (r.data, r.len, crc);
+}
+
+bool
+CPresetLog::valid (const record_t &r)
+{
+    return (r.magic == PRESET_MAGIC) && (r.id < PRESET_MAXIDS) 
+        && (r.len <= PRESET_MAXDATA) && (r.crc == checksum (r));
+}
+
+uint8_t
+CPresetLog::begin (const uint8_t *base, uint16_t pages,
+                   preset_program_fn_t program)
+{
+    m_base = base;
+    m_pages = pages > PRESET_MAXPAGES ? PRESET_MAXPAGES : pages;
+    m_program = program;
+    m_head = 0;
+    m_seq = 0;
+    m_writes = 0;
+    m_live = 0;
+    memset (m_index, 0xFF, sizeof (m_index));
+    memset (m_owner, NONE, sizeof (m_owner));
+
+    // the newest version of each id wins; the ring continues after the 
+    // newest record of all, which makes the page after it the oldest
+    for (uint16_t p = 0; p < m_pages; ++p) {
+        const record_t &r = *page (p);
+        if (!valid (r)) continue;
+        uint16_t old = m_index[r.id];
+        if (old == NOPAGE) {
+            ++m_live;
+        } else {
+            if (page (old)->seq > r.seq) continue;
+            m_owner[old] = NONE;
+        }
+        m_index[r.id] = p;
+        m_owner[p] = r.id;
+        if (r.seq >= m_seq) {
+            m_seq = r.seq;
+            m_head = p + 1 < m_pages ? p + 1 : 0;
+        }
+    }
+    return m_live;
+}
+
+uint16_t
+CPresetLog::take (uint8_t id)
+{
+    // a live record at the head is carried to the next free page, so 
+    // records that never change still move around the ring; at most one 
+    // is carried per save, others wait for the next round. The record 
+    // about to be replaced stays in place until its successor is written.
+    uint8_t carry = NONE;
+    bool carried = false;
+    for (;;) {
+        uint16_t p = m_head;
+        m_head = p + 1 < m_pages ? p + 1 : 0;
+        if (m_owner[p] != NONE) {
+            if (!carried && (m_owner[p] != id)) {
+                carry = m_owner[p];
+                carried = true;
+                memcpy (&m_scratch, page (p), PRESET_PAGE);
+            }
+            continue;
+        }
+        if (carry == NONE) return p;
+        write (p);
+        carry = NONE;
+    }
+}
+
+bool
+CPresetLog::write (uint16_t p)
+{
+    m_scratch.magic = PRESET_MAGIC;
+    m_scratch.seq = ++m_seq;
+    m_scratch.crc = checksum (m_scratch);
+    ++m_writes;
+    if (!m_program (p, (const uint32_t *) &m_scratch)
+        || memcmp (page (p), &m_scratch, PRESET_HEADER + m_scratch.len))
+        return false;
+
+    uint16_t old = m_index[m_scratch.id];
+    if (old == NOPAGE)
+        ++m_live;
+    else
+        m_owner[old] = NONE;
+    m_index[m_scratch.id] = p;
+    m_owner[p] = m_scratch.id;
+    return true;
+}
+
+bool
+CPresetLog::save (uint8_t id, const void *data, uint8_t len)
+{
+    if (!m_program || (id >= PRESET_MAXIDS) || (len > PRESET_MAXDATA)) 
+        return false;
+    // two free pages keep take() from running out of room for a carry
+    if ((m_index[id] == NOPAGE) && (m_live + 2u >= m_pages)) return false;
+
+    uint16_t p = take (id);
+    memset (&m_scratch, 0xFF, sizeof (m_scratch));
+    m_scratch.id = id;
+    m_scratch.len = len;
+    memcpy (m_scratch.data, data, len);
+    return write (p);
+}
+
+const uint8_t *
+CPresetLog::data (uint8_t id) const
+{
+    if ((id >= PRESET_MAXIDS) || (m_index[id] == NOPAGE)) return 0;
+    return page (m_index[id])->data;
+}
+
+uint8_t
+CPresetLog::length (uint8_t id) const
+{
+    if ((id >= PRESET_MAXIDS) || (m_index[id] == NOPAGE)) return 0;
+    return page (m_index[id])->len;
+}
+
+uint8_t
+CPresetLog::load (uint8_t id, void *dst, uint8_t max) const
+{
+    const uint8_t *src = data (id);
+    if (!src) return 0;
+    uint8_t len = length (id);
+    if (len > max) len = max;
+    memcpy (dst, src, len);
+    return len;
+}
@@ -0,0 +1,106 @@
+/// @file presetlog.hpp
+/// @brief Wear-leveled append-only record log on page-erased flash
+
+#ifndef _PRESETLOG_HPP_
+#define _PRESETLOG_HPP_
+
+#include <stdint.h>
+
+#define PRESET_PAGE 256             ///< bytes per flash page and record
+#define PRESET_HEADER 12            ///< bytes of record header
+#define PRESET_MAXDATA (PRESET_PAGE - PRESET_HEADER) ///< largest payload
+#define PRESET_MAXPAGES 128         ///< largest log region in pages
+#define PRESET_MAXIDS 32            ///< record ids 0..PRESET_MAXIDS-1
+#define PRESET_MAGIC 0x5250         ///< 'PR', marks a written record
+
+/// @brief Erase a log page and program it, returning false on failure
+/// @param page  Page index within the log region
+/// @param data  PRESET_PAGE bytes to program
+typedef bool (*preset_program_fn_t) (uint16_t page, const uint32_t *data);
+
+/// @brief Class keeping the latest version of up to PRESET_MAXIDS records 
+///        in a ring of flash pages, one record per page. A save programs
+///        the next page of the ring, so all pages wear evenly; live 
+///        records the ring comes around to are copied forward first. 
+///        Every record carries a sequence number and a CRC-32, so a save 
+///        torn by power loss leaves the previous version in effect. An 
+///        index in RAM maps ids to pages, so lookups do not search flash.
+class CPresetLog {
+public:
+    /// @brief Default constructor, an empty log without flash
+    CPresetLog ();
+
+    /// @brief Attach the flash region and rebuild the index from it
+    /// @param base     Memory-mapped start of the log region
+    /// @param pages    Number of pages in the region, <= PRESET_MAXPAGES
+    /// @param program  Function erasing and programming one page
+    /// @return         Number of ids with a valid record
+    uint8_t begin (const uint8_t *base, uint16_t pages,
+                   preset_program_fn_t program);
+
+    /// @brief Save a new version of a record
+    /// @param id    Record id, < PRESET_MAXIDS
+    /// @param data  Payload
+    /// @param len   Payload bytes, <= PRESET_MAXDATA
+    /// @return      false if the arguments are invalid, the log would hold
+    ///              more than pages - 2 ids or programming failed
+    bool save (uint8_t id, const void *data, uint8_t len);
+
+    /// @brief Copy the latest version of a record
+    /// @param id   Record id
+    /// @param dst  Destination
+    /// @param max  Size of the destination in bytes
+    /// @return     Payload bytes copied, 0 if the id has no record
+    uint8_t load (uint8_t id, void *dst, uint8_t max) const;
+
+    /// @brief Get the payload of a record in flash, or 0 if none
+    const uint8_t *data (uint8_t id) const;
+
+    /// @brief Get the payload length of a record, 0 if none
+    uint8_t length (uint8_t id) const;
+
+    /// @brief Get the number of pages programmed since begin(), including
+    ///        copies of live records
+    uint32_t writes () const { return m_writes; }
+
+    /// @brief Compute a CRC-32 (IEEE 802.3)
+    /// @param data  Bytes to checksum
+    /// @param len   Number of bytes
+    /// @param crc   Result of the previous call to continue, or 0
+    static uint32_t crc32 (const void *data, uint32_t len, uint32_t crc = 0);
+
+protected:
+    /// @brief A record as stored in one page
+    struct record_t {
+        uint16_t magic;                 ///< PRESET_MAGIC
+        uint8_t  id;                    ///< record id
+        uint8_t  len;                   ///< payload bytes
+        uint32_t seq;                   ///< log sequence number
+        uint32_t crc;                   ///< CRC-32 of the above and data
+        uint8_t  data[PRESET_MAXDATA];  ///< payload
+    };
+
+    const record_t *page (uint16_t p) const
+    { return (const record_t *) (m_base + (uint32_t) p * PRESET_PAGE); }
+    static uint32_t checksum (const record_t &r);
+    static bool valid (const record_t &r);
+    uint16_t take (uint8_t id);
+    bool write (uint16_t p);
+
+protected:
+    static const uint8_t NONE = 0xFF;       ///< no id owns the page
+
+    const uint8_t *m_base;                  ///< mapped log region
+    preset_program_fn_t m_program;          ///< page programming function
+    uint16_t m_pages;                       ///< pages in the log region
+    uint16_t m_head;                        ///< next page to program
+    uint32_t m_seq;                         ///< last sequence number used
+    uint32_t m_writes;                      ///< pages programmed
+    uint8_t  m_live;                        ///< ids with a record
+    uint16_t m_index[PRESET_MAXIDS];        ///< page of each id
+    uint8_t  m_owner[PRESET_MAXPAGES];      ///< id whose latest record a 
+                                            ///< page holds, or NONE
+    record_t m_scratch;                     ///< page being programmed
+};
+
+#endif // _PRESETLOG_HPP_
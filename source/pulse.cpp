@@ -0,0 +1,51 @@
+/// @file pulse.cpp
+/// @brief Pulse-train pattern tables and edge jitter statistics
+
+#include "pulse.hpp"
+
+bool
+CPulsePattern::pulses (uint16_t width, uint16_t n)
+{
+    if (m_period < 2) return false;
+    if (width >= m_period) width = m_period - 1;
+    while (n-- > 0) {
+        if (m_count >= PULSE_MAXSLOTS) return false;
+        m_table[m_count++] = width;
+    }
+    return true;
+}
+
+void
+CJitterStats::reset (uint32_t slot)
+{
+    m_slot = slot;
+    m_pulses = m_periods = m_gaps = 0;
+    m_lastrise = 0;
+    m_wmin = m_pmin = m_gmin = 0xFFFFFFFF;
+    m_wmax = m_pmax = m_gmax = 0;
+    m_psum = 0;
+}
+
+void
+CJitterStats::add (uint32_t rise, uint32_t fall)
+{
+    // unsigned differences are correct across counter wrap-around
+    uint32_t w = fall - rise;
+    if (w < m_wmin) m_wmin = w;
+    if (w > m_wmax) m_wmax = w;
+    if (m_pulses > 0) {
+        uint32_t p = rise - m_lastrise;
+        if (m_slot && (p > m_slot + m_slot / 2)) {
+            if (p < m_gmin) m_gmin = p;
+            if (p > m_gmax) m_gmax = p;
+            ++m_gaps;
+        } else {
+            if (p < m_pmin) m_pmin = p;
+            if (p > m_pmax) m_pmax = p;
+            m_psum += p;
+            ++m_periods;
+        }
+    }
+    m_lastrise = rise;
+    ++m_pulses;
+}
@@ -0,0 +1,112 @@
+/// @file pulse.hpp
+/// @brief Pulse-train pattern tables and edge jitter statistics
+
+#ifndef _PULSE_HPP_
+#define _PULSE_HPP_
+
+#include <stdint.h>
+
+#define PULSE_MAXSLOTS 256      ///< longest pattern table in periods
+
+/// @brief Class building a table of one pulse width per period slot, as
+///        the PWM PDC consumes it. A width of zero is a silent slot.
+class CPulsePattern {
+public:
+    /// @brief Default constructor, an empty pattern
+    CPulsePattern () : m_period (0), m_count (0) {}
+
+    /// @brief Start a pattern
+    /// @param period  Slot period in timer ticks, 2..65535
+    void begin (uint16_t period) { m_period = period; m_count = 0; }
+
+    /// @brief Append pulses of one width
+    /// @param width  Pulse width in ticks, < period
+    /// @param n      Number of pulses
+    /// @return       false if the table is full or the period below 2
+    bool pulses (uint16_t width, uint16_t n);
+
+    /// @brief Append silent slots
+    /// @param n  Number of slots
+    /// @return   false if the table is full
+    bool gap (uint16_t n) { return pulses (0, n); }
+
+    /// @brief Append a burst of pulses followed by a gap
+    /// @param width   Pulse width in ticks
+    /// @param burst   Pulses in the burst
+    /// @param gapn    Silent slots after the burst
+    /// @return        false if the table is full
+    bool burst (uint16_t width, uint16_t burst, uint16_t gapn) 
+    {
+        return pulses (width, burst) && gap (gapn);
+    }
+
+    /// @brief Get the slot period in ticks
+    uint16_t period () const { return m_period; }
+
+    /// @brief Get the number of slots
+    uint16_t count () const { return m_count; }
+
+    /// @brief Get the table of widths, one 32-bit word per slot
+    const uint32_t *table () const { return m_table; }
+
+protected:
+    uint32_t m_table[PULSE_MAXSLOTS];   ///< widths in ticks per slot
+    uint16_t m_period;                  ///< slot period in ticks
+    uint16_t m_count;                   ///< slots used
+};
+
+/// @brief Class accumulating pulse width and rising edge interval 
+///        statistics from captured edge timestamps. Given the slot period,
+///        intervals spanning a gap, i.e. longer than 1.5 slots, are kept
+///        apart from the intervals within a burst.
+class CJitterStats {
+public:
+    /// @brief Default constructor
+    CJitterStats () { reset (); }
+
+    /// @brief Forget all edges
+    /// @param slot  Nominal slot period in ticks, 0 to treat every 
+    ///              interval as a period within a burst
+    void reset (uint32_t slot = 0);
+
+    /// @brief Add a pulse
+    /// @param rise  Timestamp of the rising edge in ticks
+    /// @param fall  Timestamp of the falling edge in ticks
+    void add (uint32_t rise, uint32_t fall);
+
+    /// @brief Get the number of pulses added
+    uint32_t pulses () const { return m_pulses; }
+
+    /// @brief Get the peak-to-peak width jitter in ticks
+    uint32_t widthJitter () const { return m_pulses ? m_wmax - m_wmin : 0; }
+
+    /// @brief Get the peak-to-peak rising edge interval jitter within 
+    ///        bursts in ticks
+    uint32_t periodJitter () const { return m_periods ? m_pmax - m_pmin : 0; }
+
+    /// @brief Get the mean rising edge interval within bursts in ticks
+    uint32_t meanPeriod () const { return m_periods ? m_psum / m_periods : 0; }
+
+    /// @brief Get the number of intervals spanning a gap
+    uint32_t gaps () const { return m_gaps; }
+
+    /// @brief Get the peak-to-peak jitter of the intervals spanning a gap
+    uint32_t gapJitter () const { return m_gaps ? m_gmax - m_gmin : 0; }
+
+    /// @brief Get the smallest and largest width in ticks
+    uint32_t minWidth () const { return m_wmin; }
+    uint32_t maxWidth () const { return m_wmax; }
+
+protected:
+    uint32_t m_slot;        ///< nominal slot period, or 0
+    uint32_t m_pulses;      ///< pulses added
+    uint32_t m_periods;     ///< intervals within bursts
+    uint32_t m_gaps;        ///< intervals spanning a gap
+    uint32_t m_lastrise;    ///< previous rising edge
+    uint32_t m_wmin, m_wmax;///< width range
+    uint32_t m_pmin, m_pmax;///< interval range within bursts
+    uint32_t m_gmin, m_gmax;///< interval range spanning gaps
+    uint64_t m_psum;        ///< sum of intervals
+};
+
+#endif // _PULSE_HPP_
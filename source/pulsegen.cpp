@@ -0,0 +1,137 @@
+/// @file pulsegen.cpp
+/// @brief Hardware-timed pulse trains from PWM channel 0 fed by the PWM PDC
+
+#include "Arduino.h"
+#include "pulsegen.hpp"
+
+#define CAPTURE_TC TC2          // edge timestamp timer
+#define CAPTURE_TC_CH 0         // TC6, TIOA6
+#define CAPTURE_TC_ID ID_TC6
+#define SELFTEST_TIMEOUT 2000   // ms
+
+CPulseGen CPulseGen::s_singleton;
+
+// queued after a one-shot pattern so the output ends silent
+static const uint32_t silence = 0;
+
+void
+PWM_Handler ()
+{
+    CPulseGen::get ()->interrupt ();
+}
+
+void
+TC6_Handler ()
+{
+    CPulseGen::get ()->capture ();
+}
+
+void
+CPulseGen::interrupt ()
+{
+    if (!(PWM->PWM_ISR2 & PWM_ISR2_ENDTX)) return;
+    const CPulsePattern *p = m_pattern;
+    if (p && m_loop) {
+        // the PDC moved to the queued pass; queue the one after it
+        PWM->PWM_TNPR = (uint32_t) p->table ();
+        PWM->PWM_TNCR = p->count ();
+    } else if ((PWM->PWM_TCR == 0) && (PWM->PWM_TNCR == 0)) {
+        // one-shot pattern and its trailing silent slot transferred
+        PWM->PWM_IDR2 = PWM_IDR2_ENDTX;
+        m_pattern = 0;
+    }
+}
+
+void
+CPulseGen::capture ()
+{
+    uint32_t sr = CAPTURE_TC->TC_CHANNEL[CAPTURE_TC_CH].TC_SR;
+    if (sr & TC_SR_LDRBS)
+        m_stats.add (CAPTURE_TC->TC_CHANNEL[CAPTURE_TC_CH].TC_RA,
+                     CAPTURE_TC->TC_CHANNEL[CAPTURE_TC_CH].TC_RB);
+}
+
+void
+CPulseGen::begin (uint32_t tickhz)
+{
+    m_tickhz = tickhz;
+    pmc_enable_periph_clk (ID_PWM);
+    PIO_Configure (g_APinDescription[PULSEGEN_PIN].pPort, PIO_PERIPH_B,
+                   g_APinDescription[PULSEGEN_PIN].ulPin, PIO_DEFAULT);
+
+    // CLKA = MCK / 2^prea / diva with diva <= 255
+    uint32_t prea = 0, div = VARIANT_MCK / tickhz;
+    while (div > 255) {
+        div >>= 1;
+        ++prea;
+    }
+    PWM->PWM_DIS = PWM_DIS_CHID0;
+    PWM->PWM_CLK = PWM_CLK_PREA (prea) | PWM_CLK_DIVA (div);
+    // channel 0 synchronous, duty updated by the PDC every period
+    PWM->PWM_SCM = PWM_SCM_SYNC0 | PWM_SCM_UPDM_MODE2;
+    PWM->PWM_SCUP = PWM_SCUP_UPR (0);
+    PWM->PWM_CH_NUM[0].PWM_CMR = PWM_CMR_CPRE_CLKA | PWM_CMR_CPOL;
+    PWM->PWM_CH_NUM[0].PWM_CDTY = 0;
+    NVIC_SetPriority (PWM_IRQn, 1);
+    NVIC_EnableIRQ (PWM_IRQn);
+}
+
+void
+CPulseGen::start (const CPulsePattern &pattern, bool loop)
+{
+    stop ();
+    if ((pattern.period () < 2) || (pattern.count () == 0)) return;
+    m_loop = loop;
+    m_pattern = &pattern;
+    PWM->PWM_CH_NUM[0].PWM_CPRD = pattern.period ();
+    PWM->PWM_CH_NUM[0].PWM_CDTY = 0;
+    PWM->PWM_TPR = (uint32_t) pattern.table ();
+    PWM->PWM_TCR = pattern.count ();
+    PWM->PWM_TNPR = (uint32_t) (loop ? pattern.table () : &silence);
+    PWM->PWM_TNCR = loop ? pattern.count () : 1;
+    PWM->PWM_IER2 = PWM_IER2_ENDTX;
+    PWM->PWM_PTCR = PERIPH_PTCR_TXTEN;
+    PWM->PWM_ENA = PWM_ENA_CHID0;
+}
+
+void
+CPulseGen::stop ()
+{
+    PWM->PWM_IDR2 = PWM_IDR2_ENDTX;
+    PWM->PWM_PTCR = PERIPH_PTCR_TXTDIS;
+    PWM->PWM_CH_NUM[0].PWM_CDTYUPD = 0;
+    PWM->PWM_SCUC = PWM_SCUC_UPDULOCK;
+    PWM->PWM_DIS = PWM_DIS_CHID0;
+    m_pattern = 0;
+}
+
+const CJitterStats &
+CPulseGen::selfTest (uint16_t width, uint16_t period, uint16_t n)
+{
+    // capture both edges with hardware timestamps at MCK/2
+    pmc_enable_periph_clk (CAPTURE_TC_ID);
+    PIO_Configure (g_APinDescription[PULSEGEN_CAPTURE_PIN].pPort, PIO_PERIPH_B,
+                   g_APinDescription[PULSEGEN_CAPTURE_PIN].ulPin, PIO_DEFAULT);
+    TC_Configure (CAPTURE_TC, CAPTURE_TC_CH, 
+                  TC_CMR_TCCLKS_TIMER_CLOCK1 | TC_CMR_LDRA_RISING | TC_CMR_LDRB_FALLING);
+    CAPTURE_TC->TC_CHANNEL[CAPTURE_TC_CH].TC_IER = TC_IER_LDRBS;
+    m_stats.reset ((uint64_t) period * (VARIANT_MCK / 2) / m_tickhz);
+    NVIC_EnableIRQ (TC6_IRQn);
+    TC_Start (CAPTURE_TC, CAPTURE_TC_CH);
+
+    m_test.begin (period);
+    m_test.pulses (width, PULSE_MAXSLOTS);
+    start (m_test, true);
+    uint32_t t0 = millis ();
+    while ((m_stats.pulses () < n) && (millis () - t0 < SELFTEST_TIMEOUT)) ;
+    stop ();
+
+    NVIC_DisableIRQ (TC6_IRQn);
+    TC_Stop (CAPTURE_TC, CAPTURE_TC_CH);
+    return m_stats;
+}
+
+CPulseGen::CPulseGen ()
+: m_pattern (0), m_tickhz (1000000), m_loop (false)
+{
+}
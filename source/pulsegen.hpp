@@ -0,0 +1,67 @@
+/// @file pulsegen.hpp
+/// @brief Hardware-timed pulse trains from PWM channel 0 fed by the PWM PDC
+
+#ifndef _PULSEGEN_HPP_
+#define _PULSEGEN_HPP_
+
+#include "pulse.hpp"
+
+#define PULSEGEN_PIN 35         ///< PWMH0 on PC3
+#define PULSEGEN_CAPTURE_PIN 5  ///< TIOA6 on PC25, wire to PULSEGEN_PIN for selfTest()
+
+/// @brief Class generating pulse trains with PWM channel 0 as synchronous
+///        channel. The PDC loads one pulse width per period from a 
+///        CPulsePattern table, so no interrupt or busy loop elsewhere can
+///        shift an edge; the CPU only re-arms the table once per pass.
+class CPulseGen {
+public:
+    /// @brief Return the singleton CPulseGen object
+    /// @return Pointer to the singleton CPulseGen object
+    static CPulseGen *get () { return &s_singleton; }
+
+    /// @brief Configure the PWM clock and output pin
+    /// @param tickhz  Timer tick rate in Hz, a divisor of 84 MHz / 2^k
+    void begin (uint32_t tickhz = 1000000);
+
+    /// @brief Play a pattern; it must stay valid until stop(). An empty 
+    ///        pattern only stops the current one.
+    /// @param pattern  Pattern of pulse widths per period slot
+    /// @param loop     Whether to repeat the pattern until stop()
+    void start (const CPulsePattern &pattern, bool loop = true);
+
+    /// @brief Stop after the current slot
+    void stop ();
+
+    /// @brief Whether a pattern is playing
+    bool running () const { return m_pattern != 0; }
+
+    /// @brief Play a uniform train and time its edges with the TC capture
+    ///        unit on PULSEGEN_CAPTURE_PIN, which must be wired to 
+    ///        PULSEGEN_PIN. Timestamps are latched by hardware at 42 MHz.
+    /// @param width   Pulse width in ticks
+    /// @param period  Period in ticks
+    /// @param n       Pulses to time
+    /// @return        Edge statistics in 42 MHz capture ticks
+    const CJitterStats &selfTest (uint16_t width, uint16_t period, uint16_t n);
+
+    /// @brief PWM PDC end-of-transfer interrupt, called from PWM_Handler
+    void interrupt ();
+
+    /// @brief Capture interrupt, called from TC6_Handler
+    void capture ();
+
+protected:
+    /// @brief Default constructor
+    CPulseGen ();
+
+protected:
+    static CPulseGen s_singleton;           ///< The singleton generator
+
+    const CPulsePattern *volatile m_pattern;///< pattern playing, or 0
+    CPulsePattern m_test;                   ///< selfTest() pattern
+    CJitterStats m_stats;                   ///< selfTest() edge statistics
+    uint32_t m_tickhz;                      ///< PWM tick rate
+    bool m_loop;                            ///< whether m_pattern repeats
+};
+
+#endif // _PULSEGEN_HPP_
@@ -0,0 +1,123 @@
+/// @file safety.cpp
+/// @brief Output amplitude and slew limits, hold-to-stop and task check-in
+///        supervision
+
+#include <string.h>
+#include "safety.hpp"
+
+CSafety::CSafety ()
+: m_gain (SAFE_ONE), m_target (SAFE_ONE), m_step (SAFE_ONE), 
+  m_holdblocks (0), m_held (0), m_window (0), m_left (0), m_clamped (0), 
+  m_faults (0), m_first (true)
+{
+    for (uint8_t ch = 0; ch < SAFE_CHANNELS; ++ch) {
+        m_ceiling[ch] = DAC_MAX - DAC_MID;
+        m_slew[ch] = DAC_MAX;
+        m_last[ch] = 0;
+    }
+    memset (m_runs, 0, sizeof (m_runs));
+}
+
+void
+CSafety::configure (uint32_t blockrate, uint32_t holdms, uint32_t rampms,
+                    uint32_t windowms)
+{
+    m_holdblocks = holdms * blockrate / 1000;
+    uint32_t ramp = rampms * blockrate / 1000;
+    m_step = ramp ? SAFE_ONE / ramp : SAFE_ONE;
+    if (m_step == 0) m_step = 1;
+    m_window = windowms * blockrate / 1000;
+    if (m_window == 0) m_window = 1;
+    m_left = m_window;
+    m_first = true;
+}
+
+void
+CSafety::setLimits (uint8_t ch, uint16_t level, uint16_t slew)
+{
+    if (ch >= SAFE_CHANNELS) return;
+    m_ceiling[ch] = ((int32_t) level * (DAC_MAX - DAC_MID)) >> 15;
+    m_slew[ch] = slew;
+}
+
+void
+CSafety::apply (uint16_t *buf, uint16_t n)
+{
+    // the gain moves towards its target by one step per block, linearly
+    // interpolated per sample; at unity the multiply is skipped
+    uint32_t g0 = m_gain, g1 = m_target;
+    if (g1 > g0) 
+        g1 = (g1 - g0 > m_step) ? g0 + m_step : g1;
+    else
+        g1 = (g0 - g1 > m_step) ? g0 - m_step : g1;
+    m_gain = g1;
+    int32_t dg = n ? ((int32_t) g1 - (int32_t) g0) / n : 0;
+    bool unity = (g0 == SAFE_ONE) && (g1 == SAFE_ONE);
+
+    uint32_t clamped = 0;
+    for (uint8_t ch = 0; ch < SAFE_CHANNELS; ++ch) {
+        uint16_t *p = buf + ch;
+        int32_t ceiling = m_ceiling[ch], slew = m_slew[ch], last = m_last[ch];
+        int32_t g = g0;
+        for (uint16_t i = 0; i < n; ++i, p += SAFE_CHANNELS) {
+            int32_t d = (int32_t) (*p & DAC_MAX) - DAC_MID;
+            if (!unity) {
+                d = (d * (g >> 1)) >> 15;
+                g += dg;
+            }
+            int32_t c = d;
+            if (c > ceiling) c = ceiling;
+            if (c < -ceiling) c = -ceiling;
+            if (c - last > slew) c = last + slew;
+            if (last - c > slew) c = last - slew;
+            clamped += c != d;
+            last = c;
+            *p = (*p & ~DAC_MAX) | (DAC_MID + c);
+        }
+        m_last[ch] = last;
+    }
+    m_clamped += clamped;
+}
+
+bool
+CSafety::tick (bool button, const uint32_t *runs, uint8_t ntasks)
+{
+    if (ntasks > SAFE_MAXTASKS) ntasks = SAFE_MAXTASKS;
+    if (button) {
+        if (++m_held == m_holdblocks) stop (SAFE_HOLD);
+    } else {
+        m_held = 0;
+    }
+
+    if (m_first) {
+        memcpy (m_runs, runs, ntasks * sizeof (*runs));
+        m_first = false;
+        return true;
+    }
+    if (--m_left > 0) return false;
+    m_left = m_window;
+
+    // every task must have run at least once in the window
+    bool ok = true;
+    for (uint8_t i = 0; i < ntasks; ++i) {
+        if (runs[i] == m_runs[i]) ok = false;
+        m_runs[i] = runs[i];
+    }
+    if (!ok) stop (SAFE_TASKS);
+    return ok;
+}
+
+void
+CSafety::stop (uint8_t fault)
+{
+    m_faults |= fault;
+    m_target = 0;
+}
+
+void
+CSafety::rearm ()
+{
+    m_faults = 0;
+    m_held = 0;
+    m_target = SAFE_ONE;
+}
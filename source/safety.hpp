@@ -0,0 +1,88 @@
+/// @file safety.hpp
+/// @brief Output amplitude and slew limits, hold-to-stop and task check-in
+///        supervision
+
+#ifndef _SAFETY_HPP_
+#define _SAFETY_HPP_
+
+#include <stdint.h>
+#include "wavegen.hpp"
+
+#define SAFE_CHANNELS 2         ///< interleaved output channels
+#define SAFE_MAXTASKS 8         ///< largest number of supervised tasks
+#define SAFE_ONE 0x10000        ///< unity gain, Q16
+
+/// @brief Reasons for stopping the output
+enum safe_fault_t {
+    SAFE_HOLD   = 1,            ///< knob button held
+    SAFE_TASKS  = 2,            ///< a task missed its check-in window
+    SAFE_MANUAL = 4             ///< stop() called
+};
+
+/// @brief Class enforcing output limits on every sample block. Each
+///        channel's deviation from DAC_MID is clamped to a ceiling and 
+///        its change per sample to a slew limit; a stop fades the gain 
+///        to zero over the ramp time and keeps it there until rearm().
+///        tick() runs once per block and decides whether the watchdog
+///        may be fed: only if every supervised task ran in the window.
+class CSafety {
+public:
+    /// @brief Default constructor, full swing and no slew limit
+    CSafety ();
+
+    /// @brief Set the timing, all in blocks of the output
+    /// @param blockrate  Blocks per second
+    /// @param holdms     Button hold time that stops the output
+    /// @param rampms     Fade time of a stop or rearm
+    /// @param windowms   Check-in window of the supervised tasks
+    void configure (uint32_t blockrate, uint32_t holdms, uint32_t rampms,
+                    uint32_t windowms);
+
+    /// @brief Set the limits of a channel
+    /// @param ch     Channel, < SAFE_CHANNELS
+    /// @param level  Largest Q15 amplitude, 32768 = full DAC swing
+    /// @param slew   Largest change per sample in DAC codes
+    void setLimits (uint8_t ch, uint16_t level, uint16_t slew);
+
+    /// @brief Limit one block of interleaved, tagged DAC samples in place
+    /// @param buf  SAFE_CHANNELS * n samples
+    /// @param n    Samples per channel
+    void apply (uint16_t *buf, uint16_t n);
+
+    /// @brief Advance the supervision by one block
+    /// @param button  Knob button is down
+    /// @param runs    Run counter of each supervised task
+    /// @param ntasks  Number of supervised tasks
+    /// @return        true if the watchdog may be fed now
+    bool tick (bool button, const uint32_t *runs, uint8_t ntasks);
+
+    /// @brief Stop the output with a fade, recording the reason
+    void stop (uint8_t fault);
+
+    /// @brief Clear the faults and fade the output back in
+    void rearm ();
+
+    /// @brief Get the faults since the last rearm(), composed of safe_fault_t
+    uint8_t faults () const { return m_faults; }
+
+    /// @brief Get the number of samples clamped by level or slew
+    uint32_t clamped () const { return m_clamped; }
+
+protected:
+    int32_t  m_ceiling[SAFE_CHANNELS];  ///< largest deviation in DAC codes
+    int32_t  m_slew[SAFE_CHANNELS];     ///< largest change per sample
+    int32_t  m_last[SAFE_CHANNELS];     ///< last deviation sent
+    uint32_t m_runs[SAFE_MAXTASKS];     ///< task run counters at window start
+    uint32_t m_gain;                    ///< Q16 gain at the start of a block
+    uint32_t m_target;                  ///< Q16 gain to fade to
+    uint32_t m_step;                    ///< gain change per block
+    uint32_t m_holdblocks;              ///< blocks of hold that stop
+    uint32_t m_held;                    ///< blocks the button is down
+    uint32_t m_window;                  ///< blocks per check-in window
+    uint32_t m_left;                    ///< blocks left in this window
+    volatile uint32_t m_clamped;        ///< samples clamped
+    volatile uint8_t m_faults;          ///< faults since rearm()
+    bool     m_first;                   ///< no window started yet
+};
+
+#endif // _SAFETY_HPP_
@@ -0,0 +1,87 @@
+/// @file sched.cpp
+/// @brief Cooperative scheduler with static task table, priorities and
+///        deadline statistics
+
+#include "Arduino.h"
+#include "sched.hpp"
+
+CScheduler CScheduler::s_singleton;
+
+int8_t
+CScheduler::add (task_fn_t fn, void *arg, uint32_t period, uint32_t deadline,
+                 uint8_t priority)
+{
+    if (m_count >= SCHED_MAXTASKS) return -1;
+    task_t &t = m_task[m_count];
+    t.fn = fn;
+    t.arg = arg;
+    t.period = period;
+    t.deadline = deadline;
+    t.release = micros ();
+    t.signaled = 0;
+    t.priority = priority;
+    memset (&t.stats, 0, sizeof (t.stats));
+    return m_count++;
+}
+
+void
+CScheduler::signal (int8_t id)
+{
+    if ((id < 0) || (id >= m_count) || m_task[id].signaled) return;
+    m_task[id].release = micros ();
+    m_task[id].signaled = 1;
+}
+
+bool
+CScheduler::ready (task_t &t, uint32_t now)
+{
+    if (t.period == 0) return t.signaled;
+    // signed difference is correct across micros() wrap-around
+    return (int32_t) (now - t.release) >= 0;
+}
+
+bool
+CScheduler::runOnce ()
+{
+    uint32_t now = micros ();
+    task_t *next = 0;
+    for (uint8_t i = 0; i < m_count; ++i) {
+        task_t &t = m_task[i];
+        if (!ready (t, now)) continue;
+        if (!next || (t.priority < next->priority) 
+            || ((t.priority == next->priority) 
+                && ((int32_t) (t.release + t.deadline - next->release - next->deadline) < 0)))
+            next = &t;
+    }
+    if (!next) return false;
+
+    uint32_t release = next->release;
+    next->signaled = 0;
+    if (next->period) {
+        // skip releases missed entirely rather than running a backlog
+        next->release += next->period;
+        if ((int32_t) (now - next->release) >= 0)
+            next->release = now + next->period;
+    }
+    next->fn (next->arg);
+    uint32_t end = micros ();
+
+    task_stats_t &s = next->stats;
+    ++s.runs;
+    if (end - release > next->deadline) ++s.overruns;
+    if (end - now > s.maxrun) s.maxrun = end - now;
+    if (now - release > s.maxlate) s.maxlate = now - release;
+    return true;
+}
+
+void
+CScheduler::resetStats ()
+{
+    for (uint8_t i = 0; i < m_count; ++i)
+        memset (&m_task[i].stats, 0, sizeof (m_task[i].stats));
+}
+
+CScheduler::CScheduler ()
+: m_count (0)
+{
+}
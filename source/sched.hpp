@@ -0,0 +1,102 @@
+/// @file sched.hpp
+/// @brief Cooperative scheduler with static task table, priorities and
+///        deadline statistics
+
+#ifndef _SCHED_HPP_
+#define _SCHED_HPP_
+
+#include <stdint.h>
+
+#ifndef SCHED_MAXTASKS
+#define SCHED_MAXTASKS 8        ///< task table size
+#endif
+
+/// @brief A task function; it must return within its deadline
+typedef void (*task_fn_t) (void *arg);
+
+/// @brief Per-task run time statistics, all times in us
+struct task_stats_t {
+    uint32_t runs;          ///< completed runs
+    uint32_t overruns;      ///< runs finished after their deadline
+    uint32_t maxrun;        ///< longest run time
+    uint32_t maxlate;       ///< longest delay from release to start
+};
+
+/// @brief Class running periodic and event-triggered tasks from the main
+///        loop. The ready task with the highest priority (lowest number) 
+///        runs next, ties broken by earliest deadline. Tasks are never 
+///        preempted, so long work such as rendering must be split into 
+///        bounded slices, e.g. TextFrameBuffer::renderSlice(). Work with 
+///        hard deadlines, like the output refill, belongs in interrupts.
+///        Give safety checks priority 0 and a period well below their 
+///        deadline so no UI task can delay them by more than one slice.
+///        CSupervisor starves the watchdog if a periodic task stops 
+///        running, so every periodic task must run within its window.
+///
+///        static void draw (void *arg)
+///        { ((TextFrameBuffer *) arg)->renderSlice (2); }
+///        sched->add (draw, tfb, 20000, 20000, 3);
+///        for (;;) if (!sched->runOnce ()) power->waitForInterrupt ();
+class CScheduler {
+public:
+    /// @brief Return the singleton CScheduler object
+    /// @return Pointer to the singleton CScheduler object
+    static CScheduler *get () { return &s_singleton; }
+
+    /// @brief Add a task
+    /// @param fn        Task function
+    /// @param arg       Argument passed to fn
+    /// @param period    Release period in us, or 0 for an event task 
+    ///                  released by signal()
+    /// @param deadline  Deadline in us after release
+    /// @param priority  0 is the highest priority
+    /// @return          Task id, or -1 if the table is full
+    int8_t add (task_fn_t fn, void *arg, uint32_t period, uint32_t deadline,
+                uint8_t priority);
+
+    /// @brief Release an event task; safe to call from interrupts
+    /// @param id  Task id returned by add()
+    void signal (int8_t id);
+
+    /// @brief Run the next ready task, if any
+    /// @return true if a task ran, false if none was ready
+    bool runOnce ();
+
+    /// @brief Get the release period of a task in us, 0 for event tasks
+    uint32_t period (int8_t id) const { return m_task[id].period; }
+
+    /// @brief Get the statistics of a task
+    const task_stats_t &stats (int8_t id) const { return m_task[id].stats; }
+
+    /// @brief Reset the statistics of all tasks
+    void resetStats ();
+
+    /// @brief Get the number of tasks
+    uint8_t count () const { return m_count; }
+
+protected:
+    /// @brief Default constructor
+    CScheduler ();
+
+    /// @brief A task table entry
+    struct task_t {
+        task_fn_t fn;               ///< task function
+        void *arg;                  ///< argument to fn
+        uint32_t period;            ///< release period, 0 = event task
+        uint32_t deadline;          ///< deadline after release
+        uint32_t release;           ///< time of the pending release
+        volatile uint8_t signaled;  ///< event task released
+        uint8_t priority;           ///< 0 is highest
+        task_stats_t stats;         ///< run time statistics
+    };
+
+    bool ready (task_t &t, uint32_t now);
+
+protected:
+    static CScheduler s_singleton;      ///< The singleton scheduler
+
+    task_t  m_task[SCHED_MAXTASKS];     ///< task table
+    uint8_t m_count;                    ///< tasks in use
+};
+
+#endif // _SCHED_HPP_
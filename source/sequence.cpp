@@ -0,0 +1,296 @@
+/// @file sequence.cpp
+/// @brief Stimulation programs compiled to step tables and walked once per
+///        block
+
+#include <string.h>
+#include "wavegen.hpp"
+#include "sequence.hpp"
+
+static const char *const s_shapes[WAVE_SHAPES] = {
+    "sine", "square", "triangle", "saw"
+};
+
+/// @brief Skip blanks, return the first character of the next token
+static const char *
+skip (const char *p)
+{
+    while ((*p == ' ') || (*p == '\t') || (*p == '\r')) ++p;
+    return p;
+}
+
+/// @brief Read a token and advance past it
+/// @return Token length, 0 at the end of the line
+static uint8_t
+token (const char **p, const char **start)
+{
+    const char *q = *start = skip (*p);
+    while (*q && (*q != ' ') && (*q != '\t') && (*q != '\r') && (*q != '\n')
+           && (*q != '#')) 
+        ++q;
+    *p = q;
+    return (uint8_t) (q - *start);
+}
+
+/// @brief Read a decimal number with up to three fractional digits as 
+///        thousandths, e.g. "2.5" as 2500
+static bool
+number (const char **p, uint32_t *milli)
+{
+    const char *s;
+    uint8_t n = token (p, &s);
+    uint64_t v = 0;
+    int8_t frac = -1;           // fractional digits, -1 before the point
+    bool digits = false;
+    for (uint8_t i = 0; i < n; ++i) {
+        if ((s[i] == '.') && (frac < 0)) {
+            frac = 0;
+        } else if ((s[i] >= '0') && (s[i] <= '9')) {
+            digits = true;
+            if (frac >= 3) continue;
+            if (frac >= 0) ++frac;
+            v = v * 10 + (s[i] - '0');
+            if (v > 0xFFFFFFFFu) return false;
+        } else {
+            return false;
+        }
+    }
+    if (!digits) return false;
+    for (frac = frac < 0 ? 0 : frac; frac < 3; ++frac) v *= 10;
+    if (v > 0xFFFFFFFFu) return false;
+    *milli = (uint32_t) v;
+    return true;
+}
+
+CProgram::CProgram ()
+{
+    begin (1, 1);
+    end ();
+}
+
+void
+CProgram::begin (uint32_t rate, uint16_t block)
+{
+    m_n = 0;
+    m_error = 0;
+    m_line = 0;
+    m_table.steps = m_steps;
+    m_table.rate = rate;
+    m_table.block = block;
+    for (uint8_t ch = 0; ch < SEQ_CHANNELS; ++ch) {
+        m_table.count[ch] = 0;
+        m_inc[ch] = 0;
+        m_level[ch] = 0;
+        m_blocks[ch] = 0;
+    }
+}
+
+bool
+CProgram::add (const seq_segment_t &seg)
+{
+    if (m_n >= SEQ_MAXSTEPS) return fail ("too many segments");
+    if (seg.ch >= SEQ_CHANNELS) return fail ("no such channel");
+    if (seg.shape >= WAVE_SHAPES) return fail ("no such shape");
+    if ((uint64_t) seg.millihz * 2 >= (uint64_t) m_table.rate * 1000) 
+        return fail ("frequency above half the sample rate");
+    if (seg.level > 32768) return fail ("level above 100%");
+    if (seg.rampms > seg.ms) return fail ("transition longer than segment");
+
+    uint64_t perblock = (uint64_t) m_table.block * 1000;
+    uint64_t blocks = ((uint64_t) seg.ms * m_table.rate + perblock / 2) / perblock;
+    uint64_t ramp = ((uint64_t) seg.rampms * m_table.rate + perblock / 2) / perblock;
+    if (blocks == 0) return fail ("segment shorter than a block");
+    if (blocks > 0x7FFFFFFF - m_blocks[seg.ch]) return fail ("program too long");
+    if (ramp > 0xFFFF) return fail ("transition too long");
+    if (ramp > blocks) ramp = blocks;
+
+    seq_step_t &s = m_steps[m_n];
+    uint8_t ch = seg.ch;
+    s.blocks = (uint32_t) blocks;
+    s.ramp = (uint16_t) ramp;
+    s.inc = CWaveVoice::increment (seg.millihz, m_table.rate);
+    s.level = seg.level;
+    s.shape = seg.shape;
+    // the first segment of a channel fades in at its own frequency
+    uint32_t from = m_table.count[ch] ? m_inc[ch] : s.inc;
+    s.dinc = ramp ? ((int32_t) s.inc - (int32_t) from) / (int32_t) ramp : 0;
+    s.dlevel = ramp ? ((int32_t) s.level - m_level[ch]) * 256 / (int32_t) ramp : 0;
+
+    m_chan[m_n++] = ch;
+    ++m_table.count[ch];
+    m_inc[ch] = s.inc;
+    m_level[ch] = s.level;
+    m_blocks[ch] += s.blocks;
+    return true;
+}
+
+void
+CProgram::end ()
+{
+    // stable insertion sort by channel, so each channel's steps follow
+    // each other in the order they were added
+    for (uint16_t i = 1; i < m_n; ++i) {
+        seq_step_t s = m_steps[i];
+        uint8_t ch = m_chan[i];
+        uint16_t j = i;
+        for (; (j > 0) && (m_chan[j - 1] > ch); --j) {
+            m_steps[j] = m_steps[j - 1];
+            m_chan[j] = m_chan[j - 1];
+        }
+        m_steps[j] = s;
+        m_chan[j] = ch;
+    }
+}
+
+bool
+CProgram::compile (const seq_segment_t *segs, uint16_t n, uint32_t rate,
+                   uint16_t block)
+{
+    begin (rate, block);
+    for (uint16_t i = 0; i < n; ++i) {
+        if (!add (segs[i])) {
+            m_line = i + 1;
+            return false;
+        }
+    }
+    end ();
+    return true;
+}
+
+bool
+CProgram::parse (const char *text, uint32_t rate, uint16_t block)
+{
+    begin (rate, block);
+    uint8_t ch = 0;
+    for (uint16_t line = 1; *text; ++line) {
+        const char *p = text, *s;
+        // find the next line before parsing this one
+        while (*text && (*text != '\n')) ++text;
+        if (*text) ++text;
+
+        m_line = line;
+        uint8_t n = token (&p, &s);
+        if (n == 0) continue;
+        uint32_t v;
+        if ((n == 2) && !strncmp (s, "ch", 2)) {
+            if (!number (&p, &v) || (v % 1000)) return fail ("bad channel");
+            if (v / 1000 >= SEQ_CHANNELS) return fail ("no such channel");
+            ch = (uint8_t) (v / 1000);
+        } else {
+            seq_segment_t seg;
+            seg.ch = ch;
+            for (seg.shape = 0; seg.shape < WAVE_SHAPES; ++seg.shape)
+                if ((strlen (s_shapes[seg.shape]) == n) 
+                    && !strncmp (s, s_shapes[seg.shape], n)) 
+                    break;
+            if (seg.shape >= WAVE_SHAPES) return fail ("no such shape");
+            if (!number (&p, &seg.millihz)) return fail ("bad frequency");
+            if (!number (&p, &v) || (v > 100000)) return fail ("bad level");
+            seg.level = (uint16_t) (((uint64_t) v * 32768 + 50000) / 100000);
+            // seconds in thousandths are ms
+            if (!number (&p, &seg.ms)) return fail ("bad time");
+            seg.rampms = 0;
+            if ((n = token (&p, &s))) {
+                if ((n != 4) || strncmp (s, "ramp", 4) 
+                    || !number (&p, &seg.rampms)) 
+                    return fail ("expected ramp");
+            }
+            if (!add (seg)) return false;
+        }
+        if (token (&p, &s)) return fail ("extra text");
+    }
+    m_line = 0;
+    end ();
+    return true;
+}
+
+CSequencer::CSequencer ()
+: m_table (0), m_seekblock (0), m_seekserial (0), m_seekdone (0),
+  m_position (0), m_paused (true), m_finished (true)
+{
+    memset (m_cur, 0, sizeof (m_cur));
+    memset (m_out, 0, sizeof (m_out));
+}
+
+void
+CSequencer::load (const seq_table_t *table)
+{
+    m_paused = true;
+    m_table = table;
+    seek (0);
+}
+
+void
+CSequencer::seek (uint32_t ms)
+{
+    const seq_table_t *t = m_table;
+    if (!t) return;
+    m_seekblock = (uint32_t) ((uint64_t) ms * t->rate / ((uint32_t) t->block * 1000));
+    __sync_synchronize ();
+    ++m_seekserial;
+}
+
+uint32_t
+CSequencer::position () const
+{
+    const seq_table_t *t = m_table;
+    if (!t) return 0;
+    return (uint32_t) ((uint64_t) m_position * t->block * 1000 / t->rate);
+}
+
+void
+CSequencer::locate (uint32_t block)
+{
+    const seq_table_t *t = m_table;
+    const seq_step_t *steps = t->steps;
+    m_finished = true;
+    for (uint8_t ch = 0; ch < SEQ_CHANNELS; ++ch) {
+        cursor_t &c = m_cur[ch];
+        uint32_t left = block;
+        for (c.step = 0; c.step < t->count[ch]; ++c.step) {
+            if (left < steps[c.step].blocks) break;
+            left -= steps[c.step].blocks;
+        }
+        c.block = left;
+        if (c.step < t->count[ch]) m_finished = false;
+        steps += t->count[ch];
+    }
+    m_position = block;
+}
+
+bool
+CSequencer::next ()
+{
+    const seq_table_t *t = m_table;
+    uint32_t serial = m_seekserial;
+    if (t && (serial != m_seekdone)) {
+        __sync_synchronize ();
+        m_seekdone = serial;
+        locate (m_seekblock);
+    }
+    for (uint8_t ch = 0; ch < SEQ_CHANNELS; ++ch) m_out[ch].level = 0;
+    if (!t || m_paused || m_finished) return false;
+
+    // the level and increment are computed from the cursor alone, so a 
+    // seek lands on exactly the values a continuous run would have
+    const seq_step_t *steps = t->steps;
+    bool played = false;
+    for (uint8_t ch = 0; ch < SEQ_CHANNELS; ++ch) {
+        cursor_t &c = m_cur[ch];
+        if (c.step < t->count[ch]) {
+            const seq_step_t &s = steps[c.step];
+            int32_t left = (c.block < s.ramp) ? (int32_t) (s.ramp - c.block) : 0;
+            m_out[ch].inc = s.inc - (uint32_t) (s.dinc * left);
+            m_out[ch].level = (uint16_t) (s.level - ((s.dlevel * left) >> 8));
+            m_out[ch].shape = s.shape;
+            if (++c.block >= s.blocks) {
+                c.block = 0;
+                ++c.step;
+            }
+            played = true;
+        }
+        steps += t->count[ch];
+    }
+    if (played) ++m_position;
+    else m_finished = true;
+    return played;
+}
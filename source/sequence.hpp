@@ -0,0 +1,179 @@
+/// @file sequence.hpp
+/// @brief Stimulation programs compiled to step tables and walked once per
+///        block
+
+#ifndef _SEQUENCE_HPP_
+#define _SEQUENCE_HPP_
+
+#include <stdint.h>
+
+#define SEQ_CHANNELS 2          ///< output channels, as SYNTH_CHANNELS
+#define SEQ_MAXSTEPS 128        ///< largest number of segments of a program
+
+/// @brief One segment of a program as written: a waveform held for a 
+///        time, reached by a linear transition from the channel's 
+///        previous segment (from silence for the first one)
+struct seq_segment_t {
+    uint8_t  ch;                ///< output channel
+    uint8_t  shape;             ///< one of wave_shape_t
+    uint16_t level;             ///< Q15 level, 32768 = full scale
+    uint32_t millihz;           ///< frequency in mHz
+    uint32_t ms;                ///< duration including the transition
+    uint32_t rampms;            ///< transition time, <= ms
+};
+
+/// @brief One compiled segment, in blocks and phase increments of the 
+///        sample rate it was compiled for
+struct seq_step_t {
+    uint32_t blocks;            ///< duration in blocks, > 0
+    uint32_t inc;               ///< phase increment after the transition
+    int32_t  dinc;              ///< increment change per transition block
+    int32_t  dlevel;            ///< Q8 level change per transition block
+    uint16_t ramp;              ///< transition blocks, <= blocks
+    uint16_t level;             ///< Q15 level after the transition
+    uint8_t  shape;             ///< one of wave_shape_t
+};
+
+/// @brief A compiled program; may live in flash, @see host/program_check
+struct seq_table_t {
+    const seq_step_t *steps;        ///< steps of channel 0, then channel 1
+    uint16_t count[SEQ_CHANNELS];   ///< steps per channel
+    uint32_t rate;                  ///< sample rate compiled for
+    uint16_t block;                 ///< samples per block compiled for
+};
+
+/// @brief Class compiling a program into a step table in RAM, from 
+///        segments or from text (main loop or host only). Text has one 
+///        segment per line, after a line selecting the channel:
+///
+///        # warm-up, then a slow sweep     
+///        ch 0
+///        sine   80   40  30  ramp 2       <- shape Hz % s [ramp s]
+///        sine   120  60  60  ramp 5
+///        ch 1
+///        square 2.5  20  90
+class CProgram {
+public:
+    /// @brief Default constructor, empty program
+    CProgram ();
+
+    /// @brief Start a program
+    /// @param rate   Sample rate in Hz, e.g. CSynth::rate()
+    /// @param block  Samples per block, e.g. SYNTH_BLOCK
+    void begin (uint32_t rate, uint16_t block);
+
+    /// @brief Append a segment to its channel
+    /// @return false on an invalid segment, @see error()
+    bool add (const seq_segment_t &seg);
+
+    /// @brief Finish the table after the last add()
+    void end ();
+
+    /// @brief Compile segments, begin(), add() and end() in one
+    /// @return false on an invalid segment, @see error()
+    bool compile (const seq_segment_t *segs, uint16_t n, uint32_t rate,
+                  uint16_t block);
+
+    /// @brief Compile program text
+    /// @return false on an error, @see error() and errorLine()
+    bool parse (const char *text, uint32_t rate, uint16_t block);
+
+    /// @brief Get the compiled table, valid after end()
+    const seq_table_t *table () const { return &m_table; }
+
+    /// @brief Get the duration of a channel in blocks
+    uint32_t blocks (uint8_t ch) const { return m_blocks[ch]; }
+
+    /// @brief Get the last error, or 0
+    const char *error () const { return m_error; }
+
+    /// @brief Get the text line of the last error, counting from 1
+    uint16_t errorLine () const { return m_line; }
+
+protected:
+    bool fail (const char *error) { m_error = error; return false; }
+
+protected:
+    seq_step_t m_steps[SEQ_MAXSTEPS];   ///< compiled steps
+    uint8_t  m_chan[SEQ_MAXSTEPS];      ///< channel of each step until end()
+    seq_table_t m_table;                ///< table over m_steps
+    uint16_t m_n;                       ///< steps added
+    uint32_t m_inc[SEQ_CHANNELS];       ///< increment of the last segment
+    uint16_t m_level[SEQ_CHANNELS];     ///< level of the last segment
+    uint32_t m_blocks[SEQ_CHANNELS];    ///< duration per channel in blocks
+    const char *m_error;                ///< last error
+    uint16_t m_line;                    ///< text line of the last error
+};
+
+/// @brief Output of a channel for the current block
+struct seq_out_t {
+    uint32_t inc;               ///< phase increment
+    uint16_t level;             ///< Q15 level
+    uint8_t  shape;             ///< one of wave_shape_t
+};
+
+/// @brief Class walking a step table with one cursor per channel. The 
+///        refill interrupt calls next() once per block, which costs a few
+///        multiplies per channel whatever the program. The main loop 
+///        loads, seeks, pauses and resumes; seek() requests are taken at
+///        the next block, so the cursors only ever change in next().
+class CSequencer {
+public:
+    /// @brief Default constructor, no table
+    CSequencer ();
+
+    /// @brief Load a table and stop at its start (main loop only)
+    void load (const seq_table_t *table);
+
+    /// @brief Get the loaded table, or 0
+    const seq_table_t *table () const { return m_table; }
+
+    /// @brief Move the cursors to a time, taken at the next block
+    /// @param ms  Time since the program start in ms
+    void seek (uint32_t ms);
+
+    /// @brief Hold the cursors and silence the output
+    void pause () { m_paused = true; }
+
+    /// @brief Continue from the cursors
+    void resume () { m_paused = false; }
+
+    /// @brief Get whether the sequencer is paused
+    bool paused () const { return m_paused; }
+
+    /// @brief Get whether every channel is past its last step
+    bool finished () const { return m_finished; }
+
+    /// @brief Get the time since the program start in ms
+    uint32_t position () const;
+
+    /// @brief Advance by one block (refill interrupt only); channels 
+    ///        paused, finished or without a table output level 0
+    /// @return true if any channel played this block
+    bool next ();
+
+    /// @brief Get the output of a channel for the block of the last next()
+    const seq_out_t &out (uint8_t ch) const { return m_out[ch]; }
+
+protected:
+    /// @brief Position of one channel in the table
+    struct cursor_t {
+        uint16_t step;          ///< step index within the channel
+        uint32_t block;         ///< block within the step
+    };
+
+    void locate (uint32_t block);
+
+protected:
+    const seq_table_t *volatile m_table;    ///< table walked
+    volatile uint32_t m_seekblock;          ///< requested position in blocks
+    volatile uint32_t m_seekserial;         ///< incremented by seek()
+    uint32_t m_seekdone;                    ///< m_seekserial last taken
+    volatile uint32_t m_position;           ///< position in blocks
+    volatile bool m_paused;                 ///< hold the cursors
+    volatile bool m_finished;               ///< all channels ended
+    cursor_t m_cur[SEQ_CHANNELS];           ///< cursor per channel
+    seq_out_t m_out[SEQ_CHANNELS];          ///< output per channel
+};
+
+#endif // _SEQUENCE_HPP_
@@ -0,0 +1,67 @@
+/// @file supervisor.cpp
+/// @brief Output limits, hold-to-stop and watchdog in the DACC interrupt
+
+#include "Arduino.h"
+#include "knob.hpp"
+#include "sched.hpp"
+#include "synth.hpp"
+#include "supervisor.hpp"
+
+CSupervisor CSupervisor::s_singleton;
+
+// overrides the weak core hook, which disables the watchdog for good
+void
+watchdogSetup (void)
+{
+#if SUPERVISOR_WDT_MS > 0
+    watchdogEnable (SUPERVISOR_WDT_MS);
+#else
+    watchdogDisable ();
+#endif
+}
+
+void
+CSupervisor::begin (uint32_t holdms, uint32_t rampms, uint32_t windowms)
+{
+    m_active = false;
+    m_safety.configure (CSynth::get ()->rate () / SYNTH_BLOCK, holdms, 
+                        rampms, windowms);
+    m_active = true;
+}
+
+void
+CSupervisor::setLimits (uint8_t ch, uint16_t level, uint16_t slew)
+{
+    // word stores, so the interrupt sees each limit old or new
+    m_safety.setLimits (ch, level, slew);
+}
+
+void
+CSupervisor::idle ()
+{
+    if (!m_streaming) watchdogReset ();
+}
+
+void
+CSupervisor::block (uint16_t *buf, uint16_t n)
+{
+    // limits apply from the first block, even before begin()
+    m_safety.apply (buf, n);
+    if (!m_active) {
+        watchdogReset ();
+        return;
+    }
+
+    CScheduler *sched = CScheduler::get ();
+    uint8_t ntasks = 0;
+    for (uint8_t id = 0; id < sched->count () && ntasks < SAFE_MAXTASKS; ++id)
+        if (sched->period (id)) m_runs[ntasks++] = sched->stats (id).runs;
+    if (m_safety.tick (CKnob::get ()->down (), m_runs, ntasks))
+        watchdogReset ();
+}
+
+CSupervisor::CSupervisor ()
+: m_active (false), m_streaming (false)
+{
+    memset (m_runs, 0, sizeof (m_runs));
+}
@@ -0,0 +1,81 @@
+/// @file supervisor.hpp
+/// @brief Output limits, hold-to-stop and watchdog in the DACC interrupt
+
+#ifndef _SUPERVISOR_HPP_
+#define _SUPERVISOR_HPP_
+
+#include "safety.hpp"
+
+#ifndef SUPERVISOR_WDT_MS
+#define SUPERVISOR_WDT_MS 0     ///< watchdog timeout in ms, 0 disables it
+#endif
+
+/// @brief Class applying CSafety to every block CSynth renders, inside the
+///        DACC interrupt at priority 0, so neither the main loop nor a 
+///        lower interrupt can delay the limits or a stop. The watchdog is 
+///        fed from there too, but only while every periodic CScheduler 
+///        task keeps running: a hung task resets the board even though 
+///        the interrupts still fire. The watchdog is off unless a build 
+///        defines SUPERVISOR_WDT_MS. Its mode register can be written once
+///        after reset; watchdogSetup() in supervisor.cpp does so before 
+///        setup() runs, so CSynth::begin() must follow within the timeout,
+///        before slow setup such as TextFrameBuffer::configure(). Until 
+///        begin() the interrupt feeds it unconditionally; while CSynth is 
+///        stopped the main loop must call idle() instead.
+class CSupervisor {
+public:
+    /// @brief Return the singleton CSupervisor object
+    /// @return Pointer to the singleton CSupervisor object
+    static CSupervisor *get () { return &s_singleton; }
+
+    /// @brief Start supervising; call after CSynth::begin() and after 
+    ///        the periodic tasks are added
+    /// @param holdms    Knob button hold time that stops the output
+    /// @param rampms    Fade time of a stop or rearm
+    /// @param windowms  Time in which each periodic task must run once,
+    ///                  well below SUPERVISOR_WDT_MS
+    void begin (uint32_t holdms = 1500, uint32_t rampms = 50, 
+                uint32_t windowms = 200);
+
+    /// @brief Set the limits of a channel, @see CSafety::setLimits()
+    void setLimits (uint8_t ch, uint16_t level, uint16_t slew);
+
+    /// @brief Stop the output with a fade
+    void stop () { m_safety.stop (SAFE_MANUAL); }
+
+    /// @brief Clear the faults and fade the output back in
+    void rearm () { m_safety.rearm (); }
+
+    /// @brief Get the faults since the last rearm(), composed of safe_fault_t
+    uint8_t faults () const { return m_safety.faults (); }
+
+    /// @brief Get the number of samples clamped by level or slew
+    uint32_t clamped () const { return m_safety.clamped (); }
+
+    /// @brief Feed the watchdog while CSynth is stopped; call once per main
+    ///        loop iteration. Does nothing while the DACC interrupt runs.
+    void idle ();
+
+    /// @brief Tell whether the DACC interrupt feeds the watchdog, called by
+    ///        CSynth::begin() and CSynth::end()
+    void streaming (bool on) { m_streaming = on; }
+
+    /// @brief Limit and supervise one block (DACC interrupt only)
+    /// @param buf  Interleaved block of SYNTH_CHANNELS * n tagged samples
+    /// @param n    Samples per channel
+    void block (uint16_t *buf, uint16_t n);
+
+protected:
+    /// @brief Default constructor
+    CSupervisor ();
+
+protected:
+    static CSupervisor s_singleton;     ///< The singleton supervisor object
+
+    CSafety m_safety;                   ///< limits and supervision
+    uint32_t m_runs[SAFE_MAXTASKS];     ///< run counters of periodic tasks
+    volatile bool m_active;             ///< begin() was called
+    volatile bool m_streaming;          ///< CSynth feeds block()
+};
+
+#endif // _SUPERVISOR_HPP_
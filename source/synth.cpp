@@ -0,0 +1,140 @@
+/// @file synth.cpp
+/// @brief Two-channel wavetable synthesizer streaming to the SAM3X DACC
+
+#include "Arduino.h"
+#include "cycles.hpp"
+#include "synth.hpp"
+#include "supervisor.hpp"
+
+#define SYNTH_TC TC0            // trigger timer
+#define SYNTH_TC_CH 0           // TIOA0 is DACC trigger source 1
+#define SYNTH_TC_ID ID_TC0
+#define DACC_TRG_TIOA0 1        // DACC_MR TRGSEL for TIOA0
+#define DACC_TAG_SHIFT 12       // channel tag position in a half word
+
+CSynth CSynth::s_singleton;
+
+void 
+DACC_Handler ()
+{
+    CSynth::get ()->interrupt ();
+}
+
+void
+CSynth::interrupt ()
+{
+    // the PDC has moved on to the next buffer; refill the one just sent
+    // and queue it behind, as render() does with its scanlines
+    if (DACC->DACC_ISR & DACC_ISR_ENDTX) {
+        refill (m_buf[m_next]);
+        DACC->DACC_TNPR = (uint32_t) m_buf[m_next];
+        DACC->DACC_TNCR = SYNTH_BLOCK;
+        m_next = 1 - m_next;
+    }
+}
+
+void
+CSynth::refill (uint16_t *dst)
+{
+    CSequencer *seq = m_seq;
+    if (seq) seq->next ();
+    for (uint8_t ch = 0; ch < SYNTH_CHANNELS; ++ch) {
+        // time how long a followed level waited to be taken, in cycles
+        mod_source_t *src = m_mod[ch].source ();
+        bool fresh = src && (src->stamp != src->taken);
+        uint32_t applied = m_mod[ch].applied ();
+        uint32_t level = m_mod[ch].next ();
+        if (seq) {
+            const seq_out_t &out = seq->out (ch);
+            m_voice[ch].setShape (out.shape);
+            m_voice[ch].setIncrement (out.inc);
+            level = (level * out.level) >> 15;
+        }
+        m_voice[ch].glide (level);
+        if (m_mod[ch].applied () != applied) {
+            // this buffer plays after the one the PDC is sending now
+            m_appliedstamp = cycles () 
+                + (uint32_t) SYNTH_BLOCK * (VARIANT_MCK / m_rate);
+        }
+        if (fresh) {
+            src->delay = cycles () - src->stamp;
+            if (src->delay > src->maxdelay) src->maxdelay = src->delay;
+        }
+        m_voice[ch].render (dst + ch, SYNTH_BLOCK, SYNTH_CHANNELS, ch << DACC_TAG_SHIFT);
+    }
+    // nothing reaches the DAC without passing the limits
+    CSupervisor::get ()->block (dst, SYNTH_BLOCK);
+    ++m_blocks;
+}
+
+void
+CSynth::begin (uint32_t rate)
+{
+    m_rate = rate;
+    m_blocks = 0;
+    cycles_begin ();
+    for (uint8_t ch = 0; ch < SYNTH_CHANNELS; ++ch)
+        m_mod[ch].setBlockRate (rate / SYNTH_BLOCK);
+    m_next = 0;
+    refill (m_buf[0]);
+    refill (m_buf[1]);
+
+    pmc_enable_periph_clk (ID_DACC);
+    DACC->DACC_CR = DACC_CR_SWRST;
+    // word transfers of two tagged half words, one conversion per trigger
+    DACC->DACC_MR = DACC_MR_TRGEN_EN 
+                  | DACC_MR_TRGSEL (DACC_TRG_TIOA0)
+                  | DACC_MR_WORD_WORD
+                  | DACC_MR_TAG_EN
+                  | DACC_MR_REFRESH (1)
+                  | DACC_MR_STARTUP_8;
+    DACC->DACC_CHER = DACC_CHER_CH0 | DACC_CHER_CH1;
+
+    // PDC ping-pong: current and next buffer, each one word per sample pair
+    DACC->DACC_PTCR = PERIPH_PTCR_TXTDIS;
+    DACC->DACC_TPR = (uint32_t) m_buf[0];
+    DACC->DACC_TCR = SYNTH_BLOCK;
+    DACC->DACC_TNPR = (uint32_t) m_buf[1];
+    DACC->DACC_TNCR = SYNTH_BLOCK;
+    DACC->DACC_IER = DACC_IER_ENDTX;
+    NVIC_SetPriority (DACC_IRQn, 0);
+    NVIC_EnableIRQ (DACC_IRQn);
+    DACC->DACC_PTCR = PERIPH_PTCR_TXTEN;
+
+    // TIOA0 toggles at twice the sample rate, one trigger per channel
+    pmc_enable_periph_clk (SYNTH_TC_ID);
+    TC_Configure (SYNTH_TC, SYNTH_TC_CH, 
+                  TC_CMR_TCCLKS_TIMER_CLOCK1 | TC_CMR_WAVE | TC_CMR_WAVSEL_UP_RC 
+                | TC_CMR_ACPA_CLEAR | TC_CMR_ACPC_SET);
+    uint32_t rc = VARIANT_MCK / 2 / (SYNTH_CHANNELS * rate);
+    TC_SetRC (SYNTH_TC, SYNTH_TC_CH, rc);
+    TC_SetRA (SYNTH_TC, SYNTH_TC_CH, rc / 2);
+    TC_Start (SYNTH_TC, SYNTH_TC_CH);
+    CSupervisor::get ()->streaming (true);
+}
+
+bool
+CSynth::play (CSequencer *seq)
+{
+    const seq_table_t *t = seq ? seq->table () : 0;
+    if (t && ((t->rate != m_rate) || (t->block != SYNTH_BLOCK))) return false;
+    m_seq = seq;
+    return true;
+}
+
+void
+CSynth::end ()
+{
+    TC_Stop (SYNTH_TC, SYNTH_TC_CH);
+    DACC->DACC_IDR = DACC_IDR_ENDTX;
+    DACC->DACC_PTCR = PERIPH_PTCR_TXTDIS;
+    NVIC_DisableIRQ (DACC_IRQn);
+    // the main loop feeds the watchdog from now on, @see CSupervisor::idle()
+    CSupervisor::get ()->streaming (false);
+}
+
+CSynth::CSynth ()
+: m_seq (0), m_rate (SYNTH_RATE), m_blocks (0), m_appliedstamp (0), m_next (0)
+{
+    memset (m_buf, 0, sizeof (m_buf));
+}
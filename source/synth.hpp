@@ -0,0 +1,89 @@
+/// @file synth.hpp
+/// @brief Two-channel wavetable synthesizer streaming to the SAM3X DACC
+
+#ifndef _SYNTH_HPP_
+#define _SYNTH_HPP_
+
+#include "wavegen.hpp"
+#include "modulate.hpp"
+#include "sequence.hpp"
+
+#define SYNTH_CHANNELS 2        ///< DAC channels, one per output board channel
+
+#ifndef SYNTH_RATE
+#define SYNTH_RATE 20000        ///< default sample rate in Hz per channel
+#endif
+
+#ifndef SYNTH_BLOCK
+#define SYNTH_BLOCK 64          ///< samples per channel and DMA buffer
+#endif
+
+/// @brief Class streaming wavetable voices to the DACC. A timer triggers 
+///        the conversions and the DACC PDC reads ping-pong buffers which 
+///        the end-of-transfer interrupt refills, so sample timing does not
+///        depend on the main loop.
+class CSynth {
+public:
+    /// @brief Return the singleton CSynth object
+    /// @return Pointer to the singleton CSynth object
+    static CSynth *get () { return &s_singleton; }
+
+    /// @brief Start streaming to both DAC channels
+    /// @param rate  Sample rate in Hz per channel
+    void begin (uint32_t rate = SYNTH_RATE);
+
+    /// @brief Stop streaming and the trigger timer; with the watchdog on,
+    ///        call CSupervisor::idle() from the main loop afterwards
+    void end ();
+
+    /// @brief Get the voice feeding a DAC channel
+    /// @param ch  Channel, 0 <= ch < SYNTH_CHANNELS
+    CWaveVoice &voice (uint8_t ch) { return m_voice[ch]; }
+
+    /// @brief Get the level modulator of a DAC channel. Its level is 
+    ///        evaluated once per block and glided to within the block.
+    /// @param ch  Channel, 0 <= ch < SYNTH_CHANNELS
+    CModulator &modulator (uint8_t ch) { return m_mod[ch]; }
+
+    /// @brief Let a sequencer set shape, frequency and level of the voices
+    ///        each block; the modulator levels still scale its levels
+    /// @param seq  Sequencer with a table compiled for rate() and 
+    ///             SYNTH_BLOCK, or 0 to return control to the main loop
+    /// @return     false if the loaded table was compiled for another rate
+    bool play (CSequencer *seq);
+
+    /// @brief Get the sample rate in Hz per channel
+    uint32_t rate () const { return m_rate; }
+
+    /// @brief Get the number of blocks rendered since begin()
+    uint32_t blocks () const { return m_blocks; }
+
+    /// @brief Get the cycle counter time at which the block taking the 
+    ///        latest modulator update starts to play, @see cycles()
+    uint32_t appliedStamp () const { return m_appliedstamp; }
+
+    /// @brief Render one interleaved block of both channels
+    /// @param dst  Buffer of SYNTH_CHANNELS * SYNTH_BLOCK tagged samples
+    void refill (uint16_t *dst);
+
+    /// @brief DACC end-of-transfer interrupt, called from DACC_Handler
+    void interrupt ();
+
+protected:
+    /// @brief Default constructor
+    CSynth ();
+
+protected:
+    static CSynth s_singleton;          ///< The singleton synth object
+
+    CWaveVoice m_voice[SYNTH_CHANNELS]; ///< voices per DAC channel
+    CModulator m_mod[SYNTH_CHANNELS];   ///< level modulators per DAC channel
+    uint16_t m_buf[2][SYNTH_CHANNELS * SYNTH_BLOCK]; ///< PDC ping-pong buffers
+    CSequencer *volatile m_seq;         ///< sequencer playing, or 0
+    uint32_t m_rate;                    ///< sample rate per channel
+    volatile uint32_t m_blocks;         ///< blocks rendered since begin()
+    volatile uint32_t m_appliedstamp;   ///< play time of the last update
+    uint8_t m_next;                     ///< buffer to refill next
+};
+
+#endif // _SYNTH_HPP_
@@ -0,0 +1,150 @@
+/// @file telemetry.cpp
+/// @brief Channel telemetry and text screen mirroring over the native 
+///        USB serial port, @see tlmproto.hpp
+
+#include "Arduino.h"
+#include "telemetry.hpp"
+#include "synth.hpp"
+#include "power.hpp"
+
+CTelemetry CTelemetry::s_singleton;
+
+void
+CTelemetry::begin (TextFrameBuffer *tfb, uint32_t periodms)
+{
+    m_tfb = tfb;
+    m_periodms = periodms;
+    m_lastms = millis ();
+    if (tfb) tfb->setMirror (mirror);
+    SerialUSB.begin (115200);
+}
+
+void
+CTelemetry::mirror (coord_t y0, coord_t y1)
+{
+    for (coord_t y = y0; y < y1; ++y)
+        s_singleton.m_dirty |= 1UL << y;
+}
+
+void
+CTelemetry::resync ()
+{
+    // the receiver holds nothing: a geometry frame clears it, and every
+    // cell not blank differs from the cleared shadow
+    m_ring.clear ();
+    m_cols = m_tfb->cols ();
+    m_rows = m_tfb->rows ();
+    uint8_t body[2] = { (uint8_t) m_cols, (uint8_t) m_rows };
+    m_ring.frame (TLM_SCREEN, body, 2, false);
+    memset (m_shadow, 0, sizeof (m_shadow));
+    for (coord_t y = 0; y < TFB_ROWS; ++y)
+        for (coord_t x = 0; x < TFB_COLS; ++x)
+            m_shadow[y][x][0] = ' ';
+    m_dirty = (1UL << m_rows) - 1;
+}
+
+bool
+CTelemetry::channels (const uint16_t *levels, uint8_t n, uint8_t state)
+{
+    if (!m_connected) return false;
+    uint8_t body[TLM_MAXBODY];
+    uint32_t ms = millis ();
+    if (n > (TLM_MAXBODY - 6) / 2) n = (TLM_MAXBODY - 6) / 2;
+    memcpy (body, &ms, 4);
+    body[4] = state;
+    body[5] = n;
+    memcpy (body + 6, levels, 2 * n);
+    return m_ring.frame (TLM_CHANNELS, body, 6 + 2 * n);
+}
+
+bool
+CTelemetry::flush (uint8_t *body, uint16_t &len, uint32_t &rows)
+{
+    if (len == 0) return true;
+    if (!m_ring.frame (TLM_CELLS, body, len, false)) return false;
+    // the rows are on their way: the receiver now holds these cells
+    for (coord_t y = 0; rows; ++y, rows >>= 1)
+        if (rows & 1) {
+            memcpy (m_shadow[y], m_tfb->shownRow (y), 2 * m_cols);
+            m_dirty &= ~(1UL << y);
+        }
+    len = 0;
+    return true;
+}
+
+void
+CTelemetry::cells ()
+{
+    uint8_t body[TLM_MAXBODY];
+    uint16_t len = 0;
+    uint32_t rows = 0;
+    for (coord_t y = 0; y < m_rows; ++y) {
+        if (!(m_dirty & (1UL << y))) continue;
+        const uint8_t *row = m_tfb->shownRow (y);
+        const uint8_t (*old)[2] = m_shadow[y];
+
+        // runs of changed cells; gaps of one unchanged cell are sent 
+        // along, as a new run header costs more than the cell
+        uint8_t runs[3 * TFB_COLS / 2 + 2 * TFB_COLS];
+        uint16_t n = 0;
+        coord_t x = 0;
+        while (x < m_cols) {
+            if (!memcmp (row + 2 * x, old[x], 2)) { ++x; continue; }
+            coord_t x1 = x + 1;
+            while ((x1 < m_cols) && (memcmp (row + 2 * x1, old[x1], 2)
+                   || ((x1 + 1 < m_cols) && memcmp (row + 2 * x1 + 2, old[x1+1], 2))))
+                ++x1;
+            runs[n++] = y;
+            runs[n++] = x;
+            runs[n++] = x1 - x;
+            memcpy (runs + n, row + 2 * x, 2 * (x1 - x));
+            n += 2 * (x1 - x);
+            x = x1;
+        }
+        if (n == 0) {
+            m_dirty &= ~(1UL << y);
+            continue;
+        }
+        if ((len + n > TLM_MAXBODY) && !flush (body, len, rows)) return;
+        memcpy (body + len, runs, n);
+        len += n;
+        rows |= 1UL << y;
+    }
+    flush (body, len, rows);
+}
+
+void
+CTelemetry::poll ()
+{
+    bool up = SerialUSB;
+    if (up && !m_connected && m_tfb) resync ();
+    m_connected = up;
+    if (!up) return;
+
+    if (m_tfb) {
+        if ((m_tfb->cols () != m_cols) || (m_tfb->rows () != m_rows)) 
+            resync ();
+        if (m_dirty) cells ();
+    }
+    if (m_periodms && (millis () - m_lastms >= m_periodms)) {
+        m_lastms += m_periodms;
+        uint16_t levels[SYNTH_CHANNELS];
+        for (uint8_t ch = 0; ch < SYNTH_CHANNELS; ++ch)
+            levels[ch] = CSynth::get ()->voice (ch).level ();
+        channels (levels, SYNTH_CHANNELS, CPower::get ()->mode ());
+    }
+
+    // the SAM core's CDC write waits for a free endpoint bank per packet,
+    // so write at most one packet per call and only while the host has 
+    // the port open
+    const uint8_t *data;
+    uint16_t n = m_ring.peek (&data);
+    if (n > TLM_CHUNK) n = TLM_CHUNK;
+    if (n > 0) m_ring.consume (SerialUSB.write (data, n));
+}
+
+CTelemetry::CTelemetry ()
+: m_tfb (0), m_dirty (0), m_periodms (0), m_lastms (0), m_cols (0), 
+  m_rows (0), m_connected (false)
+{
+}
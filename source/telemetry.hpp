@@ -0,0 +1,72 @@
+/// @file telemetry.hpp
+/// @brief Channel telemetry and text screen mirroring over the native 
+///        USB serial port, @see tlmproto.hpp
+
+#ifndef _TELEMETRY_HPP_
+#define _TELEMETRY_HPP_
+
+#include "ST7735.hpp"
+#include "tlmproto.hpp"
+
+#ifndef TLM_CHUNK
+#define TLM_CHUNK 64            ///< largest write to SerialUSB per poll(),
+                                ///< one full speed bulk packet
+#endif
+
+/// @brief Class streaming telemetry frames to SerialUSB. Screen updates 
+///        come from the rows TextFrameBuffer renders: changed cells are 
+///        found against a copy of what the receiver holds, and rows that
+///        do not fit into the ring stay pending, so a slow receiver gets
+///        fewer, larger updates instead of a stale screen. Channel frames
+///        are dropped when the ring is full. poll() writes at most one 
+///        bulk packet, so it waits at most for one endpoint bank to free.
+class CTelemetry {
+public:
+    /// @brief Return the singleton CTelemetry object
+    /// @return Pointer to the singleton CTelemetry object
+    static CTelemetry *get () { return &s_singleton; }
+
+    /// @brief Start the USB serial port and mirror a frame buffer
+    /// @param tfb       Frame buffer to mirror, or 0 for none
+    /// @param periodms  Interval of channel frames in ms, 0 for none
+    void begin (TextFrameBuffer *tfb, uint32_t periodms);
+
+    /// @brief Queue a channel frame; dropped if the ring is full
+    /// @param levels  Q15 levels
+    /// @param n       Number of levels
+    /// @param state   Device state, e.g. the CPower mode
+    /// @return        false if dropped
+    bool channels (const uint16_t *levels, uint8_t n, uint8_t state);
+
+    /// @brief Queue periodic channel frames and screen updates and pass 
+    ///        queued bytes to USB. Call once per main loop iteration or 
+    ///        from a CScheduler task.
+    void poll ();
+
+    /// @brief Get the number of frames dropped for lack of room
+    uint32_t dropped () const { return m_ring.dropped (); }
+
+protected:
+    /// @brief Default constructor
+    CTelemetry ();
+
+    static void mirror (coord_t y0, coord_t y1);
+    void resync ();
+    void cells ();
+    bool flush (uint8_t *body, uint16_t &len, uint32_t &rows);
+
+protected:
+    static CTelemetry s_singleton;      ///< The singleton telemetry object
+
+    CTlmRing m_ring;                    ///< transmit ring
+    TextFrameBuffer *m_tfb;             ///< mirrored frame buffer
+    uint8_t  m_shadow[TFB_ROWS][TFB_COLS][2];  ///< cells the receiver holds
+    volatile uint32_t m_dirty;          ///< rows rendered but not sent
+    uint32_t m_periodms;                ///< channel frame interval
+    uint32_t m_lastms;                  ///< millis() of last channel frame
+    coord_t  m_cols;                    ///< grid width the receiver holds
+    coord_t  m_rows;                    ///< grid height the receiver holds
+    bool     m_connected;               ///< a host has the port open
+};
+
+#endif // _TELEMETRY_HPP_
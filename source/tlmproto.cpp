@@ -0,0 +1,109 @@
+/// @file tlmproto.cpp
+/// @brief Framed binary telemetry protocol
+
+#include <string.h>
+#include "tlmproto.hpp"
+
+uint16_t
+tlm_crc16 (const uint8_t *data, uint16_t len, uint16_t crc)
+{
+    while (len-- > 0) {
+        crc ^= (uint16_t) *data++ << 8;
+        for (uint8_t i = 0; i < 8; ++i)
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+bool
+CTlmRing::frame (uint8_t type, const uint8_t *body, uint16_t len, bool drop)
+{
+    if ((len > TLM_MAXBODY) || !room (len)) {
+        if (drop) {
+            ++m_seq;
+            ++m_dropped;
+        }
+        return false;
+    }
+    uint8_t hdr[2] = { type, m_seq++ };
+    uint16_t crc = tlm_crc16 (body, len, tlm_crc16 (hdr, 2));
+    uint8_t trl[2] = { (uint8_t) crc, (uint8_t) (crc >> 8) };
+    const uint8_t *part[3] = { hdr, body, trl };
+    uint16_t plen[3] = { 2, len, 2 };
+
+    // COBS: each block starts with a code byte, the distance to the next
+    // zero, patched in once the block ends
+    uint16_t h = m_head, code_at = h;
+    uint8_t code = 1;
+    put (h, 0);
+    for (uint8_t k = 0; k < 3; ++k)
+        for (uint16_t i = 0; i < plen[k]; ++i) {
+            uint8_t b = part[k][i];
+            if (b != 0) {
+                put (h, b);
+                ++code;
+            }
+            if ((b == 0) || (code == 0xFF)) {
+                m_buf[code_at] = code;
+                code_at = h;
+                code = 1;
+                put (h, 0);
+            }
+        }
+    m_buf[code_at] = code;
+    put (h, 0);
+    m_head = h;
+    return true;
+}
+
+uint16_t
+CTlmRing::peek (const uint8_t **data) const
+{
+    *data = m_buf + m_tail;
+    return (m_head >= m_tail) ? m_head - m_tail : TLM_RING - m_tail;
+}
+
+CTlmDecoder::CTlmDecoder (tlm_frame_fn_t fn, void *arg)
+: m_fn (fn), m_arg (arg), m_len (0), m_left (0), m_zero (false),
+  m_bad (false), m_synced (false), m_seq (0), m_errors (0), m_lost (0)
+{
+}
+
+void
+CTlmDecoder::put (uint8_t b)
+{
+    if (b == 0) {
+        // end of frame; the zero implied by the last block is dropped
+        if (m_len > 0 || m_bad) {
+            if (m_bad || (m_left > 0) || (m_len < 4)
+                || (tlm_crc16 (m_frame, m_len - 2) 
+                    != (m_frame[m_len-2] | (m_frame[m_len-1] << 8)))) {
+                ++m_errors;
+            } else {
+                if (m_synced) m_lost += (uint8_t) (m_frame[1] - m_seq);
+                m_synced = true;
+                m_seq = m_frame[1] + 1;
+                m_fn (m_frame[0], m_frame[1], m_frame + 2, m_len - 4, m_arg);
+            }
+        }
+        m_len = 0;
+        m_left = 0;
+        m_zero = false;
+        m_bad = false;
+        return;
+    }
+    if (m_bad) return;
+    if (m_left == 0) {
+        // a code byte: emit the zero ending the previous block first
+        if (m_zero) {
+            if (m_len >= sizeof (m_frame)) { m_bad = true; return; }
+            m_frame[m_len++] = 0;
+        }
+        m_left = b - 1;
+        m_zero = b != 0xFF;
+        return;
+    }
+    if (m_len >= sizeof (m_frame)) { m_bad = true; return; }
+    m_frame[m_len++] = b;
+    --m_left;
+}
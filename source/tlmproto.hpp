@@ -0,0 +1,132 @@
+/// @file tlmproto.hpp
+/// @brief Framed binary telemetry protocol
+///
+/// A frame is type (1), sequence number (1), body and CRC-16/CCITT (2, 
+/// little endian) over type, sequence and body, COBS encoded and ended 
+/// by a zero byte. A receiver resynchronizes at the next zero byte and
+/// detects lost frames from gaps in the sequence numbers. Bodies:
+///
+///   TLM_SCREEN    cols (1), rows (1); the receiver clears its screen
+///   TLM_CELLS     runs of y (1), x (1), n (1), n * (char (1), attr (1))
+///   TLM_CHANNELS  time ms (4), state (1), n (1), n * Q15 level (2)
+
+#ifndef _TLMPROTO_HPP_
+#define _TLMPROTO_HPP_
+
+#include <stdint.h>
+
+#ifndef TLM_RING
+#define TLM_RING 2048           ///< transmit ring bytes, a power of two
+#endif
+
+#define TLM_MAXBODY 120         ///< largest frame body in bytes
+#define TLM_MAXFRAME (TLM_MAXBODY + 4 + (TLM_MAXBODY + 4) / 254 + 2)
+                                ///< largest encoded frame with delimiter
+
+/// @brief Frame types
+enum tlm_type_t {
+    TLM_SCREEN = 1,     ///< text grid geometry
+    TLM_CELLS,          ///< changed text cells
+    TLM_CHANNELS        ///< channel levels and device state
+};
+
+/// @brief Compute a CRC-16/CCITT (polynomial 0x1021)
+/// @param data  Bytes to checksum
+/// @param len   Number of bytes
+/// @param crc   Result of the previous call to continue, or 0xFFFF
+uint16_t tlm_crc16 (const uint8_t *data, uint16_t len, uint16_t crc = 0xFFFF);
+
+/// @brief Class encoding frames into a transmit ring buffer. Frames are 
+///        queued whole or not at all, so a full ring never blocks the 
+///        caller; the caller decides whether to retry or drop.
+class CTlmRing {
+public:
+    /// @brief Default constructor, an empty ring
+    CTlmRing () : m_head (0), m_tail (0), m_seq (0), m_dropped (0) {}
+
+    /// @brief Queue a frame
+    /// @param type  One of tlm_type_t
+    /// @param body  Frame body
+    /// @param len   Body bytes, <= TLM_MAXBODY
+    /// @param drop  Count a full ring as a lost frame, using up a 
+    ///              sequence number, rather than expecting a retry
+    /// @return      false if the ring has no room for the frame
+    bool frame (uint8_t type, const uint8_t *body, uint16_t len, 
+                bool drop = true);
+
+    /// @brief Get whether a frame of a body length fits
+    bool room (uint16_t len) const
+    { return TLM_RING - 1 - used () >= len + 4 + (len + 4) / 254 + 2; }
+
+    /// @brief Get the number of queued bytes
+    uint16_t used () const { return (m_head - m_tail) & (TLM_RING - 1); }
+
+    /// @brief Get the queued bytes that are contiguous in the ring
+    /// @param data  Pointer to receive the first queued byte
+    /// @return      Number of contiguous bytes
+    uint16_t peek (const uint8_t **data) const;
+
+    /// @brief Remove bytes after they were sent
+    void consume (uint16_t n) { m_tail = (m_tail + n) & (TLM_RING - 1); }
+
+    /// @brief Discard all queued bytes. The first of them may continue a
+    ///        frame already partly sent, so a lone delimiter is queued in
+    ///        their place: the receiver drops that frame as bad instead of
+    ///        joining it to the next one.
+    void clear ()
+    {
+        if (used () == 0) return;
+        m_tail = m_head;
+        put (m_head, 0);
+    }
+
+    /// @brief Get the number of frames dropped for lack of room
+    uint32_t dropped () const { return m_dropped; }
+
+protected:
+    void put (uint16_t &i, uint8_t b) { m_buf[i] = b; i = (i + 1) & (TLM_RING - 1); }
+
+protected:
+    uint8_t  m_buf[TLM_RING];   ///< ring storage
+    uint16_t m_head;            ///< next byte to write
+    uint16_t m_tail;            ///< next byte to send
+    uint8_t  m_seq;             ///< sequence number of the next frame
+    uint32_t m_dropped;         ///< frames dropped
+};
+
+/// @brief A decoded frame sink
+typedef void (*tlm_frame_fn_t) (uint8_t type, uint8_t seq, 
+                                const uint8_t *body, uint16_t len, void *arg);
+
+/// @brief Class decoding a byte stream into frames
+class CTlmDecoder {
+public:
+    /// @brief Constructor
+    /// @param fn   Sink called for every frame with a valid CRC
+    /// @param arg  Argument passed to fn
+    CTlmDecoder (tlm_frame_fn_t fn, void *arg);
+
+    /// @brief Decode one received byte
+    void put (uint8_t b);
+
+    /// @brief Get the number of frames with a bad CRC or length
+    uint32_t errors () const { return m_errors; }
+
+    /// @brief Get the number of frames lost by sequence number gaps
+    uint32_t lost () const { return m_lost; }
+
+protected:
+    tlm_frame_fn_t m_fn;                ///< frame sink
+    void *m_arg;                        ///< argument passed to m_fn
+    uint8_t  m_frame[TLM_MAXBODY + 4];  ///< decoded frame
+    uint16_t m_len;                     ///< decoded bytes
+    uint8_t  m_left;                    ///< data bytes left in the block
+    bool     m_zero;                    ///< a zero follows the block
+    bool     m_bad;                     ///< frame overflowed
+    bool     m_synced;                  ///< a previous frame was received
+    uint8_t  m_seq;                     ///< expected sequence number
+    uint32_t m_errors;                  ///< bad frames
+    uint32_t m_lost;                    ///< frames missing in the sequence
+};
+
+#endif // _TLMPROTO_HPP_
@@ -0,0 +1,62 @@
+/// @file wavegen.cpp
+/// @brief Fixed-point wavetable oscillator
+
+#include "wavegen.hpp"
+
+// Single-cycle wavetables
+#include "wavetable.i"
+
+CWaveVoice::CWaveVoice ()
+: m_table (s_tables[WAVE_SINE]), m_phase (0), m_inc (0), m_level (0), m_target (0)
+{
+}
+
+void
+CWaveVoice::setShape (uint8_t shape)
+{
+    if (shape < WAVE_SHAPES)
+        m_table = s_tables[shape];
+}
+
+void
+CWaveVoice::setFrequency (uint32_t millihz, uint32_t rate)
+{
+    m_inc = increment (millihz, rate);
+}
+
+uint32_t
+CWaveVoice::increment (uint32_t millihz, uint32_t rate)
+{
+    return (uint32_t) (((uint64_t) millihz << 32) / ((uint64_t) rate * 1000));
+}
+
+void
+CWaveVoice::render (uint16_t *dst, uint16_t n, uint16_t stride, uint16_t tag)
+{
+    // copy the volatile parameters once per block
+    const int16_t *table = m_table;
+    uint32_t phase = m_phase;
+    uint32_t inc = m_inc;
+    uint16_t target = m_target;
+    int32_t level = (int32_t) m_level << 15;
+    int32_t dlevel = n ? (((int32_t) target << 15) - level) / n : 0;
+    while (n-- > 0) {
+        // linear interpolation between adjacent table entries; a Q15
+        // fraction keeps the product of a full-scale jump within 32 bits
+        uint32_t i = phase >> (32 - WAVE_BITS);
+        int32_t a = table[i];
+        int32_t b = table[(i + 1) & (WAVE_SIZE - 1)];
+        int32_t frac = (phase >> (17 - WAVE_BITS)) & 0x7FFF;
+        int32_t s = a + (((b - a) * frac) >> 15);
+        // scale by level and map Q15 to unsigned DAC codes
+        s = DAC_MID + (((s * (level >> 15)) >> 15) >> (16 - DAC_BITS));
+        if (s < 0) s = 0;
+        if (s > DAC_MAX) s = DAC_MAX;
+        *dst = s | tag;
+        dst += stride;
+        phase += inc;
+        level += dlevel;
+    }
+    m_phase = phase;
+    m_level = target;
+}
@@ -0,0 +1,85 @@
+/// @file wavegen.hpp
+/// @brief Fixed-point wavetable oscillator
+
+#ifndef _WAVEGEN_HPP_
+#define _WAVEGEN_HPP_
+
+#include <stdint.h>
+
+#define WAVE_BITS 8                 ///< log2 of the wavetable size
+#define WAVE_SIZE (1 << WAVE_BITS)  ///< samples per wavetable cycle
+
+#define DAC_BITS 12                 ///< DAC resolution
+#define DAC_MID (1 << (DAC_BITS-1)) ///< DAC code of the zero level
+#define DAC_MAX ((1 << DAC_BITS)-1) ///< largest DAC code
+
+/// @brief Wave shapes, in the order of the wavetables
+enum wave_shape_t {
+    WAVE_SINE = 0,
+    WAVE_SQUARE,
+    WAVE_TRIANGLE,
+    WAVE_SAW,
+    WAVE_SHAPES
+};
+
+/// @brief A wavetable oscillator with a 32-bit phase accumulator
+class CWaveVoice {
+public:
+    /// @brief Default constructor, silent sine
+    CWaveVoice ();
+
+    /// @brief Select the wave shape
+    /// @param shape  One of wave_shape_t
+    void setShape (uint8_t shape);
+
+    /// @brief Set the oscillator frequency
+    /// @param millihz  Frequency in mHz
+    /// @param rate     Sample rate in Hz
+    void setFrequency (uint32_t millihz, uint32_t rate);
+
+    /// @brief Set the phase increment per sample, @see increment()
+    void setIncrement (uint32_t inc) { m_inc = inc; }
+
+    /// @brief Get the phase increment per sample of a frequency
+    /// @param millihz  Frequency in mHz
+    /// @param rate     Sample rate in Hz
+    static uint32_t increment (uint32_t millihz, uint32_t rate);
+
+    /// @brief Set the output level immediately
+    /// @param level  Q15 level, 32768 = full scale
+    void setLevel (uint16_t level) { m_level = level; m_target = level; }
+
+    /// @brief Glide linearly to a level over the next render() call, so 
+    ///        block-wise level updates reach the output without steps
+    /// @param level  Q15 level, 32768 = full scale
+    void glide (uint16_t level) { m_target = level; }
+
+    /// @brief Get the output level as Q15
+    uint16_t level () const { return m_level; }
+
+    /// @brief Restart the waveform at phase zero
+    void reset () { m_phase = 0; }
+
+    /// @brief Render samples as unsigned DAC codes ORed with a tag
+    /// @param dst     First destination sample
+    /// @param n       Number of samples to render
+    /// @param stride  Distance between destination samples, e.g. 2 for
+    ///                interleaved channels
+    /// @param tag     Bits ORed into each sample, e.g. a DACC channel tag
+    void render (uint16_t *dst, uint16_t n, uint16_t stride, uint16_t tag);
+
+    /// @brief Get a Q15 wavetable
+    /// @param shape  One of wave_shape_t
+    static const int16_t *table (uint8_t shape) { return s_tables[shape]; }
+
+protected:
+    static const int16_t s_tables[WAVE_SHAPES][WAVE_SIZE];  ///< Q15 wavetables
+
+    const int16_t *volatile m_table;  ///< current wavetable
+    uint32_t m_phase;                 ///< phase accumulator, one cycle = 2^32
+    volatile uint32_t m_inc;          ///< phase increment per sample
+    volatile uint16_t m_level;        ///< Q15 output level
+    volatile uint16_t m_target;       ///< Q15 level at the end of next render()
+};
+
+#endif // _WAVEGEN_HPP_
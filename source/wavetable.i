@@ -0,0 +1,146 @@
+/// @file wavetable.i
+/// @brief Single-cycle wavetables of WAVE_SIZE signed Q15 samples, to be 
+/// included in wavegen.cpp. Order follows wave_shape_t.
+
+const int16_t CWaveVoice::s_tables[WAVE_SHAPES][WAVE_SIZE] = {
+    // WAVE_SINE
+    {
+             0,    804,   1608,   2410,   3212,   4011,   4808,   5602,
+          6393,   7179,   7962,   8739,   9512,  10278,  11039,  11793,
+         12539,  13279,  14010,  14732,  15446,  16151,  16846,  17530,
+         18204,  18868,  19519,  20159,  20787,  21403,  22005,  22594,
+         23170,  23731,  24279,  24811,  25329,  25832,  26319,  26790,
+         27245,  27683,  28105,  28510,  28898,  29268,  29621,  29956,
+         30273,  30571,  30852,  31113,  31356,  31580,  31785,  31971,
+         32137,  32285,  32412,  32521,  32609,  32678,  32728,  32757,
+         32767,  32757,  32728,  32678,  32609,  32521,  32412,  32285,
+         32137,  31971,  31785,  31580,  31356,  31113,  30852,  30571,
+         30273,  29956,  29621,  29268,  28898,  28510,  28105,  27683,
+         27245,  26790,  26319,  25832,  25329,  24811,  24279,  23731,
+         23170,  22594,  22005,  21403,  20787,  20159,  19519,  18868,
+         18204,  17530,  16846,  16151,  15446,  14732,  14010,  13279,
+         12539,  11793,  11039,  10278,   9512,   8739,   7962,   7179,
+          6393,   5602,   4808,   4011,   3212,   2410,   1608,    804,
+             0,   -804,  -1608,  -2410,  -3212,  -4011,  -4808,  -5602,
+         -6393,  -7179,  -7962,  -8739,  -9512, -10278, -11039, -11793,
+        -12539, -13279, -14010, -14732, -15446, -16151, -16846, -17530,
+        -18204, -18868, -19519, -20159, -20787, -21403, -22005, -22594,
+        -23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790,
+        -27245, -27683, -28105, -28510, -28898, -29268, -29621, -29956,
+        -30273, -30571, -30852, -31113, -31356, -31580, -31785, -31971,
+        -32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757,
+        -32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285,
+        -32137, -31971, -31785, -31580, -31356, -31113, -30852, -30571,
+        -30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683,
+        -27245, -26790, -26319, -25832, -25329, -24811, -24279, -23731,
+        -23170, -22594, -22005, -21403, -20787, -20159, -19519, -18868,
+        -18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279,
+        -12539, -11793, -11039, -10278,  -9512,  -8739,  -7962,  -7179,
+         -6393,  -5602,  -4808,  -4011,  -3212,  -2410,  -1608,   -804
+    },
+    // WAVE_SQUARE
+    {
+         32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+         32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+         32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+         32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+         32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+         32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+         32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+         32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+         32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+         32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+         32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+         32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+         32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+         32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+         32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+         32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+        -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+        -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+        -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+        -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+        -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+        -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+        -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+        -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+        -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+        -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+        -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+        -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+        -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+        -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+        -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+        -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767
+    },
+    // WAVE_TRIANGLE
+    {
+             0,    512,   1024,   1536,   2048,   2560,   3072,   3584,
+          4096,   4608,   5120,   5632,   6144,   6656,   7168,   7680,
+          8192,   8704,   9216,   9728,  10240,  10752,  11264,  11776,
+         12288,  12800,  13312,  13824,  14336,  14848,  15360,  15872,
+         16384,  16895,  17407,  17919,  18431,  18943,  19455,  19967,
+         20479,  20991,  21503,  22015,  22527,  23039,  23551,  24063,
+         24575,  25087,  25599,  26111,  26623,  27135,  27647,  28159,
+         28671,  29183,  29695,  30207,  30719,  31231,  31743,  32255,
+         32767,  32255,  31743,  31231,  30719,  30207,  29695,  29183,
+         28671,  28159,  27647,  27135,  26623,  26111,  25599,  25087,
+         24575,  24063,  23551,  23039,  22527,  22015,  21503,  20991,
+         20479,  19967,  19455,  18943,  18431,  17919,  17407,  16895,
+         16384,  15872,  15360,  14848,  14336,  13824,  13312,  12800,
+         12288,  11776,  11264,  10752,  10240,   9728,   9216,   8704,
+          8192,   7680,   7168,   6656,   6144,   5632,   5120,   4608,
+          4096,   3584,   3072,   2560,   2048,   1536,   1024,    512,
+             0,   -512,  -1024,  -1536,  -2048,  -2560,  -3072,  -3584,
+         -4096,  -4608,  -5120,  -5632,  -6144,  -6656,  -7168,  -7680,
+         -8192,  -8704,  -9216,  -9728, -10240, -10752, -11264, -11776,
+        -12288, -12800, -13312, -13824, -14336, -14848, -15360, -15872,
+        -16384, -16895, -17407, -17919, -18431, -18943, -19455, -19967,
+        -20479, -20991, -21503, -22015, -22527, -23039, -23551, -24063,
+        -24575, -25087, -25599, -26111, -26623, -27135, -27647, -28159,
+        -28671, -29183, -29695, -30207, -30719, -31231, -31743, -32255,
+        -32767, -32255, -31743, -31231, -30719, -30207, -29695, -29183,
+        -28671, -28159, -27647, -27135, -26623, -26111, -25599, -25087,
+        -24575, -24063, -23551, -23039, -22527, -22015, -21503, -20991,
+        -20479, -19967, -19455, -18943, -18431, -17919, -17407, -16895,
+        -16384, -15872, -15360, -14848, -14336, -13824, -13312, -12800,
+        -12288, -11776, -11264, -10752, -10240,  -9728,  -9216,  -8704,
+         -8192,  -7680,  -7168,  -6656,  -6144,  -5632,  -5120,  -4608,
+         -4096,  -3584,  -3072,  -2560,  -2048,  -1536,  -1024,   -512
+    },
+    // WAVE_SAW
+    {
+        -32767, -32510, -32253, -31996, -31739, -31482, -31225, -30968,
+        -30711, -30454, -30197, -29940, -29683, -29426, -29169, -28912,
+        -28655, -28398, -28141, -27884, -27627, -27370, -27113, -26856,
+        -26599, -26342, -26085, -25828, -25571, -25314, -25057, -24800,
+        -24543, -24286, -24029, -23772, -23515, -23258, -23001, -22744,
+        -22487, -22230, -21973, -21716, -21459, -21202, -20945, -20688,
+        -20431, -20174, -19917, -19660, -19403, -19146, -18889, -18632,
+        -18375, -18118, -17861, -17604, -17347, -17090, -16833, -16576,
+        -16319, -16062, -15805, -15548, -15291, -15034, -14777, -14520,
+        -14263, -14006, -13749, -13492, -13235, -12978, -12721, -12464,
+        -12207, -11950, -11693, -11436, -11179, -10922, -10665, -10408,
+        -10151,  -9894,  -9637,  -9380,  -9123,  -8866,  -8609,  -8352,
+         -8095,  -7838,  -7581,  -7324,  -7067,  -6810,  -6553,  -6296,
+         -6039,  -5782,  -5525,  -5268,  -5011,  -4754,  -4497,  -4240,
+         -3983,  -3726,  -3469,  -3212,  -2955,  -2698,  -2441,  -2184,
+         -1927,  -1670,  -1413,  -1156,   -899,   -642,   -385,   -128,
+           128,    385,    642,    899,   1156,   1413,   1670,   1927,
+          2184,   2441,   2698,   2955,   3212,   3469,   3726,   3983,
+          4240,   4497,   4754,   5011,   5268,   5525,   5782,   6039,
+          6296,   6553,   6810,   7067,   7324,   7581,   7838,   8095,
+          8352,   8609,   8866,   9123,   9380,   9637,   9894,  10151,
+         10408,  10665,  10922,  11179,  11436,  11693,  11950,  12207,
+         12464,  12721,  12978,  13235,  13492,  13749,  14006,  14263,
+         14520,  14777,  15034,  15291,  15548,  15805,  16062,  16319,
+         16576,  16833,  17090,  17347,  17604,  17861,  18118,  18375,
+         18632,  18889,  19146,  19403,  19660,  19917,  20174,  20431,
+         20688,  20945,  21202,  21459,  21716,  21973,  22230,  22487,
+         22744,  23001,  23258,  23515,  23772,  24029,  24286,  24543,
+         24800,  25057,  25314,  25571,  25828,  26085,  26342,  26599,
+         26856,  27113,  27370,  27627,  27884,  28141,  28398,  28655,
+         28912,  29169,  29426,  29683,  29940,  30197,  30454,  30711,
+         30968,  31225,  31482,  31739,  31996,  32253,  32510,  32767
+    }
+};
@@ -0,0 +1,334 @@
+/// @file widget.cpp
+/// @brief Retained-mode widgets on the text frame buffer with knob focus
+
+#include "Arduino.h"
+#include "knob.hpp"
+#include "widget.hpp"
+
+/// @brief Swap foreground and background of an attribute
+#define ATTR_INVERT(at) ((uint8_t) (((at) >> 4) | ((at) << 4)))
+
+void
+CLabel::draw (TextFrameBuffer *tfb, uint8_t at)
+{
+    uint8_t old = tfb->textAttr ();
+    tfb->textAttr (at);
+    coord_t n = m_text ? strlen (m_text) : 0;
+    if (n > m_w) n = m_w;
+    if (n > 0) tfb->textOut (m_x, m_y, m_text, n);
+    for (coord_t x = m_x + n; x < m_x + m_w; ++x)
+        tfb->putChAt (x, m_y, ' ', at);
+    tfb->textAttr (old);
+}
+
+void
+CNumber::setRange (int32_t min, int32_t max, int32_t step)
+{
+    m_min = min;
+    m_max = max;
+    m_step = step;
+    m_focusable = step != 0;
+}
+
+bool
+CNumber::changed ()
+{
+    int32_t v = *m_value;
+    if (v == m_shown) return false;
+    m_shown = v;
+    return true;
+}
+
+void
+CNumber::draw (TextFrameBuffer *tfb, uint8_t at)
+{
+    tfb->fieldOut (m_x, m_y, m_field.attr (at), m_shown);
+}
+
+void
+CNumber::turn (int32_t rel)
+{
+    int32_t v = *m_value + rel * m_step;
+    if (v < m_min) v = m_min;
+    if (v > m_max) v = m_max;
+    *m_value = v;
+}
+
+bool
+CGauge::changed ()
+{
+    int32_t v = *m_value;
+    if (v < 0) v = 0;
+    if (v > m_max) v = m_max;
+    uint8_t half = m_max > 0 ? (int64_t) v * 2 * m_w / m_max : 0;
+    if (half == m_half) return false;
+    m_half = half;
+    return true;
+}
+
+void
+CGauge::draw (TextFrameBuffer *tfb, uint8_t at)
+{
+    uint8_t old = tfb->textAttr ();
+    tfb->textAttr (at);
+    tfb->hbar (m_x, m_y, m_half, 2 * m_w);
+    tfb->textAttr (old);
+}
+
+CMeter::CMeter (coord_t x, coord_t y, coord_t w, 
+                const volatile int32_t *value, int32_t max, uint8_t slot, 
+                uint8_t at)
+: CWidget (x, y, w, at), m_value (value), m_max (max), 
+  m_edge (slot < METER_GLYPHS ? METER_FULL + 1 + 2 * slot : 0), 
+  m_holdms (0), m_decayms (0), m_fill (0), m_peak (0), m_held (0), 
+  m_since (0), m_dfill (0), m_dpeak (0), m_dat (at)
+{
+}
+
+void
+CMeter::setPeak (uint16_t holdms, uint16_t decayms)
+{
+    m_holdms = holdms;
+    m_decayms = decayms;
+    invalidate ();
+}
+
+bool
+CMeter::changed ()
+{
+    if (!m_edge) return false;
+    int32_t v = *m_value;
+    if (v < 0) v = 0;
+    if (v > m_max) v = m_max;
+    uint16_t px = m_w * FONTWIDTH;
+    uint16_t fill = m_max > 0 ? (int64_t) v * px / m_max : 0;
+
+    uint16_t peak = 0;
+    if (m_holdms) {
+        uint32_t now = millis ();
+        uint32_t age = now - m_since;
+        uint32_t fall = 0;
+        if (age > m_holdms) 
+            fall = m_decayms ? (age - m_holdms) * px / m_decayms : px;
+        peak = (fall < m_held) ? m_held - fall : 0;
+        if (fill >= peak) {
+            m_held = peak = fill;
+            m_since = now;
+        }
+    }
+    if ((fill == m_fill) && (peak == m_peak)) return false;
+    m_fill = fill;
+    m_peak = peak;
+    return true;
+}
+
+uint8_t
+CMeter::cell (coord_t i, uint16_t fill, uint16_t peak) const
+{
+    int16_t f = (int16_t) fill - i * FONTWIDTH;
+    if (f >= FONTWIDTH) return METER_FULL;
+    if (f > 0) return m_edge;
+    if ((peak > fill) && ((peak - 1) / FONTWIDTH == i)) return m_edge + 1;
+    return EMPTY;
+}
+
+void
+CMeter::draw (TextFrameBuffer *tfb, uint8_t at)
+{
+    // the bar covers the middle rows, the marker the full height
+    if (!m_edge) return;
+    const uint8_t barrows = 0x7E, bar = (1 << FONTWIDTH) - 1;
+    uint8_t rows[FONTHEIGHT], edge[FONTHEIGHT], mark[FONTHEIGHT];
+    uint8_t f = m_fill % FONTWIDTH;
+    bool peak = m_peak > m_fill;
+    uint8_t m = peak ? 1 << ((m_peak - 1) % FONTWIDTH) : 0;
+    bool inedge = peak && f && ((m_peak - 1) / FONTWIDTH == m_fill / FONTWIDTH);
+    for (uint8_t j = 0; j < FONTHEIGHT; ++j) {
+        bool b = barrows & (1 << j);
+        rows[j] = b ? bar : 0;
+        edge[j] = (b ? (1 << f) - 1 : 0) | (inedge ? m : 0);
+        mark[j] = m;
+    }
+    // glyphs first: a changed one redraws the cells already showing it
+    tfb->setGlyph (METER_FULL, rows);
+    tfb->setGlyph (m_edge, edge);
+    tfb->setGlyph (m_edge + 1, mark);
+
+    bool all = m_invalid || (at != m_dat);
+    for (coord_t i = 0; i < m_w; ++i) {
+        uint8_t c = cell (i, m_fill, m_peak);
+        if (all || (c != cell (i, m_dfill, m_dpeak)))
+            tfb->putChAt (m_x + i, m_y, c, at);
+    }
+    m_dfill = m_fill;
+    m_dpeak = m_peak;
+    m_dat = at;
+}
+
+CList::CList (coord_t x, coord_t y, coord_t w, coord_t rows, 
+              const char *const *items, uint8_t count, uint8_t at)
+: CWidget (x, y, w, at), m_items (items), m_rows (rows), m_count (count), 
+  m_sel (0), m_top (0)
+{
+    m_focusable = true;
+}
+
+void
+CList::setItems (const char *const *items, uint8_t count)
+{
+    m_items = items;
+    m_count = count;
+    m_sel = m_top = 0;
+    invalidate ();
+}
+
+void
+CList::select (uint8_t index)
+{
+    if (index >= m_count) return;
+    m_sel = index;
+    if (m_sel < m_top) m_top = m_sel;
+    if (m_sel >= m_top + m_rows) m_top = m_sel - m_rows + 1;
+    invalidate ();
+}
+
+void
+CList::turn (int32_t rel)
+{
+    if (m_count == 0) return;
+    int32_t i = m_sel + rel;
+    if (i < 0) i = 0;
+    if (i >= m_count) i = m_count - 1;
+    if (i != m_sel) select (i);
+}
+
+void
+CList::drawItems (TextFrameBuffer *tfb, coord_t x, coord_t y, uint8_t at)
+{
+    uint8_t old = tfb->textAttr ();
+    for (coord_t r = 0; r < m_rows; ++r) {
+        uint8_t i = m_top + r;
+        const char *s = i < m_count ? m_items[i] : "";
+        uint8_t a = (i == m_sel) ? at : m_at;
+        coord_t n = strlen (s);
+        if (n > m_w) n = m_w;
+        tfb->textAttr (a);
+        if (n > 0) tfb->textOut (x, y + r, s, n);
+        for (coord_t cx = x + n; cx < x + m_w; ++cx)
+            tfb->putChAt (cx, y + r, ' ', a);
+    }
+    tfb->textAttr (old);
+}
+
+void
+CList::draw (TextFrameBuffer *tfb, uint8_t at)
+{
+    // without focus the selection is still marked, in inverse colors
+    drawItems (tfb, m_x, m_y, at == m_at ? ATTR_INVERT (m_at) : at);
+}
+
+void
+CMenu::draw (TextFrameBuffer *tfb, uint8_t at)
+{
+    uint8_t old = tfb->textAttr ();
+    tfb->textAttr (at);
+    tfb->frame (m_x, m_y, m_x + m_w + 2, m_y + m_rows + 2);
+    tfb->textAttr (old);
+    drawItems (tfb, m_x + 1, m_y + 1, ATTR_INVERT (m_at));
+}
+
+bool
+CMenu::push (bool captured)
+{
+    if (!captured) return true;
+    if (m_fn && (m_sel < m_count)) m_fn (m_sel, m_arg);
+    return false;
+}
+
+CScreen::CScreen (uint8_t focusat, uint8_t editat)
+: m_first (0), m_last (0), m_focus (0), m_focusat (focusat), 
+  m_editat (editat), m_captured (false)
+{
+}
+
+void
+CScreen::add (CWidget &w)
+{
+    w.m_next = 0;
+    w.m_invalid = true;
+    if (m_last) 
+        m_last->m_next = &w;
+    else
+        m_first = &w;
+    m_last = &w;
+    if (!m_focus && w.focusable ()) m_focus = &w;
+}
+
+void
+CScreen::invalidate ()
+{
+    for (CWidget *w = m_first; w; w = w->m_next)
+        w->m_invalid = true;
+}
+
+void
+CScreen::update (TextFrameBuffer *tfb)
+{
+    for (CWidget *w = m_first; w; w = w->m_next) {
+        // sample first so the value drawn is the one compared next time
+        bool c = w->changed ();
+        if (!c && !w->m_invalid) continue;
+        uint8_t at = w->m_at;
+        if (w == m_focus) at = m_captured ? m_editat : m_focusat;
+        w->draw (tfb, at);
+        w->m_invalid = false;
+    }
+}
+
+void
+CScreen::focus (CWidget *w)
+{
+    if (w == m_focus) return;
+    if (m_focus) m_focus->invalidate ();
+    if (w) w->invalidate ();
+    m_focus = w;
+    m_captured = false;
+}
+
+void
+CScreen::input (uint8_t bits, uint8_t pressed, int32_t relative)
+{
+    if ((bits & CKnob::BIT_PUSH) && pressed && m_focus) {
+        m_captured = m_focus->push (m_captured);
+        m_focus->invalidate ();
+    }
+    if (relative == 0) return;
+    if (m_captured) {
+        m_focus->turn (relative);
+        return;
+    }
+
+    // move the focus by one focusable widget per knob step, wrapping
+    CWidget *f = m_focus;
+    if (!f) return;
+    for (; relative != 0; relative += (relative > 0) ? -1 : 1) {
+        CWidget *first = 0, *last = 0, *before = 0, *after = 0;
+        bool seen = false;
+        for (CWidget *w = m_first; w; w = w->m_next) {
+            if (!w->focusable ()) continue;
+            if (!first) first = w;
+            if (w == f) 
+                seen = true;
+            else if (!seen) 
+                before = w;
+            else if (!after) 
+                after = w;
+            last = w;
+        }
+        if (relative > 0)
+            f = after ? after : first;
+        else
+            f = before ? before : last;
+    }
+    focus (f);
+}
@@ -0,0 +1,267 @@
+/// @file widget.hpp
+/// @brief Retained-mode widgets on the text frame buffer with knob focus
+
+#ifndef _WIDGET_HPP_
+#define _WIDGET_HPP_
+
+#include "ST7735.hpp"
+
+/// @brief Base class of all widgets. A widget occupies cells of one or 
+///        more rows and draws only those. It is redrawn when its bound 
+///        value has changed as drawn or after invalidate(), so an idle 
+///        screen costs one compare per widget and dirties no cells.
+class CWidget {
+public:
+    /// @brief Constructor
+    /// @param x   Left character column
+    /// @param y   Top character row
+    /// @param w   Width in characters
+    /// @param at  Attribute when not focused, @see ATTR macro
+    CWidget (coord_t x, coord_t y, coord_t w, uint8_t at)
+    : m_next (0), m_x (x), m_y (y), m_w (w), m_at (at), 
+      m_focusable (false), m_invalid (true) {}
+
+    /// @brief Sample the bound value
+    /// @return true if it differs from the value drawn last
+    virtual bool changed () { return false; }
+
+    /// @brief Draw the widget with the sampled value
+    /// @param tfb  Frame buffer to draw to
+    /// @param at   Attribute to draw with, reflecting focus
+    virtual void draw (TextFrameBuffer *tfb, uint8_t at) = 0;
+
+    /// @brief Handle a knob push while focused
+    /// @param captured  Whether the widget holds the knob
+    /// @return          Whether the widget holds the knob afterwards, 
+    ///                  receiving turns instead of moving the focus
+    virtual bool push (bool) { return false; }
+
+    /// @brief Handle knob turns while the widget holds the knob
+    /// @param rel  Relative knob movement
+    virtual void turn (int32_t) {}
+
+    /// @brief Redraw on the next CScreen::update()
+    void invalidate () { m_invalid = true; }
+
+    /// @brief Get whether the widget can take the focus
+    bool focusable () const { return m_focusable; }
+
+protected:
+    friend class CScreen;
+
+    CWidget *m_next;        ///< next widget of the screen, in focus order
+    coord_t  m_x;           ///< left character column
+    coord_t  m_y;           ///< top character row
+    coord_t  m_w;           ///< width in characters
+    uint8_t  m_at;          ///< attribute when not focused
+    bool     m_focusable;   ///< widget takes the focus
+    bool     m_invalid;     ///< redraw regardless of the value
+};
+
+/// @brief A fixed or rarely changing string, blank padded to its width
+class CLabel : public CWidget {
+public:
+    CLabel (coord_t x, coord_t y, coord_t w, const char *text, uint8_t at)
+    : CWidget (x, y, w, at), m_text (text) {}
+
+    /// @brief Replace the text
+    void setText (const char *text) { m_text = text; invalidate (); }
+
+    virtual void draw (TextFrameBuffer *tfb, uint8_t at);
+
+protected:
+    const char *m_text;     ///< text shown
+};
+
+/// @brief A number bound to a variable, formatted by a field_t. With 
+///        setRange() it becomes focusable and the knob edits the variable
+///        after a push.
+class CNumber : public CWidget {
+public:
+    CNumber (coord_t x, coord_t y, const field_t &f, 
+             volatile int32_t *value, uint8_t at)
+    : CWidget (x, y, f.width, at), m_field (f), m_value (value), 
+      m_shown (0), m_min (0), m_max (0), m_step (0) {}
+
+    /// @brief Make the number editable
+    /// @param min   Smallest value
+    /// @param max   Largest value
+    /// @param step  Change per knob step
+    void setRange (int32_t min, int32_t max, int32_t step);
+
+    virtual bool changed ();
+    virtual void draw (TextFrameBuffer *tfb, uint8_t at);
+    virtual bool push (bool captured) { return !captured; }
+    virtual void turn (int32_t rel);
+
+protected:
+    field_t m_field;            ///< number format
+    volatile int32_t *m_value;  ///< bound variable
+    int32_t m_shown;            ///< value drawn
+    int32_t m_min;              ///< smallest value when editing
+    int32_t m_max;              ///< largest value when editing
+    int32_t m_step;             ///< change per knob step
+};
+
+/// @brief A horizontal bar gauge bound to a variable, drawn with hbar() 
+///        at half-character resolution. It is redrawn only when the bar
+///        length changes, not on every change of the value.
+class CGauge : public CWidget {
+public:
+    CGauge (coord_t x, coord_t y, coord_t w, const volatile int32_t *value,
+            int32_t max, uint8_t at)
+    : CWidget (x, y, w, at), m_value (value), m_max (max), m_half (0) {}
+
+    virtual bool changed ();
+    virtual void draw (TextFrameBuffer *tfb, uint8_t at);
+
+protected:
+    const volatile int32_t *m_value;    ///< bound variable
+    int32_t m_max;                      ///< value of a full bar
+    uint8_t m_half;                     ///< half characters drawn
+};
+
+#define METER_FULL TFB_GLYPH0               ///< full cell glyph of all meters
+#define METER_GLYPHS ((TFB_GLYPHS - 1) / 2) ///< number of meter slots
+
+/// @brief A horizontal level meter bound to a variable, at pixel 
+///        resolution, with an optional decaying peak-hold marker. Each
+///        meter slot owns two RAM glyphs, @see TextFrameBuffer::setGlyph(),
+///        for the cell holding the bar's end and the one holding the 
+///        marker. A level change within a cell and every step of the 
+///        marker rewrite just one of them, so one cell is sent; only 
+///        cells whose glyph changes are drawn, never the whole bar.
+class CMeter : public CWidget {
+public:
+    /// @brief Constructor
+    /// @param slot  Meter slot, < METER_GLYPHS, unique per meter shown;
+    ///              a meter with a slot out of range draws nothing
+    CMeter (coord_t x, coord_t y, coord_t w, const volatile int32_t *value,
+            int32_t max, uint8_t slot, uint8_t at);
+
+    /// @brief Show a peak-hold marker
+    /// @param holdms   Time a peak is held
+    /// @param decayms  Time the marker then takes to fall over the full
+    ///                 width; the marker never falls below the bar
+    void setPeak (uint16_t holdms, uint16_t decayms);
+
+    virtual bool changed ();
+    virtual void draw (TextFrameBuffer *tfb, uint8_t at);
+
+protected:
+    /// @brief Get the codepoint of a cell for a bar and marker length
+    uint8_t cell (coord_t i, uint16_t fill, uint16_t peak) const;
+
+protected:
+    const volatile int32_t *m_value;    ///< bound variable
+    int32_t  m_max;                     ///< value of a full bar
+    uint8_t  m_edge;                    ///< glyph of the bar end cell, 0 if
+                                        ///< the slot is out of range
+    uint16_t m_holdms;                  ///< peak hold time, 0 for no marker
+    uint16_t m_decayms;                 ///< marker fall time over the width
+    uint16_t m_fill;                    ///< bar pixels sampled
+    uint16_t m_peak;                    ///< marker pixels sampled
+    uint16_t m_held;                    ///< marker pixels at m_since
+    uint32_t m_since;                   ///< millis() of the last peak
+    uint16_t m_dfill;                   ///< bar pixels drawn
+    uint16_t m_dpeak;                   ///< marker pixels drawn
+    uint8_t  m_dat;                     ///< attribute drawn
+};
+
+/// @brief A scrolling list of strings with a selected item. A push lets
+///        the knob move the selection, another push releases it.
+class CList : public CWidget {
+public:
+    CList (coord_t x, coord_t y, coord_t w, coord_t rows, 
+           const char *const *items, uint8_t count, uint8_t at);
+
+    /// @brief Replace the items
+    void setItems (const char *const *items, uint8_t count);
+
+    /// @brief Select an item, scrolling it into view
+    void select (uint8_t index);
+
+    /// @brief Get the selected item
+    uint8_t selected () const { return m_sel; }
+
+    virtual void draw (TextFrameBuffer *tfb, uint8_t at);
+    virtual bool push (bool captured) { return !captured; }
+    virtual void turn (int32_t rel);
+
+protected:
+    /// @brief Draw the visible items at a position, the selected one 
+    ///        with an attribute
+    void drawItems (TextFrameBuffer *tfb, coord_t x, coord_t y, uint8_t at);
+
+protected:
+    const char *const *m_items; ///< item strings
+    coord_t m_rows;             ///< visible rows
+    uint8_t m_count;            ///< number of items
+    uint8_t m_sel;              ///< selected item
+    uint8_t m_top;              ///< first visible item
+};
+
+/// @brief A framed list whose items trigger an action. A push enters 
+///        the menu, turns choose, and a second push runs the action.
+class CMenu : public CList {
+public:
+    /// @brief An action, called with the chosen item and the menu's arg
+    typedef void (*action_fn_t) (uint8_t item, void *arg);
+
+    /// @brief Constructor, the frame takes one cell around the items
+    CMenu (coord_t x, coord_t y, coord_t w, coord_t rows, 
+           const char *const *items, uint8_t count, action_fn_t fn, 
+           void *arg, uint8_t at)
+    : CList (x, y, w, rows, items, count, at), m_fn (fn), m_arg (arg) {}
+
+    virtual void draw (TextFrameBuffer *tfb, uint8_t at);
+    virtual bool push (bool captured);
+
+protected:
+    action_fn_t m_fn;       ///< action of all items
+    void *m_arg;            ///< argument passed to m_fn
+};
+
+/// @brief A set of widgets drawn to the frame buffer, one of which holds
+///        the focus. Knob turns move the focus between focusable widgets
+///        unless the focused widget holds the knob after a push.
+class CScreen {
+public:
+    /// @brief Constructor
+    /// @param focusat  Attribute of the focused widget
+    /// @param editat   Attribute of the focused widget holding the knob
+    CScreen (uint8_t focusat, uint8_t editat);
+
+    /// @brief Append a widget; widgets take the focus in the order added
+    void add (CWidget &w);
+
+    /// @brief Redraw all widgets on the next update(), e.g. after the 
+    ///        screen's page was used for something else
+    void invalidate ();
+
+    /// @brief Draw changed widgets. Only their cells become dirty.
+    /// @param tfb  Frame buffer with the screen's page selected for drawing
+    void update (TextFrameBuffer *tfb);
+
+    /// @brief Route a knob reading, @see CKnob::query
+    /// @param bits      Pending CKnob::BIT_xxx values
+    /// @param pressed   Push button state
+    /// @param relative  Relative knob movement
+    void input (uint8_t bits, uint8_t pressed, int32_t relative);
+
+    /// @brief Move the focus to a widget, or 0 for none
+    void focus (CWidget *w);
+
+    /// @brief Get the focused widget, or 0
+    CWidget *focused () const { return m_focus; }
+
+protected:
+    CWidget *m_first;       ///< first widget
+    CWidget *m_last;        ///< last widget
+    CWidget *m_focus;       ///< focused widget, or 0
+    uint8_t  m_focusat;     ///< attribute of the focused widget
+    uint8_t  m_editat;      ///< attribute of a widget holding the knob
+    bool     m_captured;    ///< focused widget holds the knob
+};
+
+#endif // _WIDGET_HPP_